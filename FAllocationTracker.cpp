@@ -0,0 +1,288 @@
+/*
+ * FAllocationTracker.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FAllocationTracker.hpp"
+#include "FLogger.hpp"
+
+#ifdef FTHREAD_TRACK_ALLOCATIONS
+#include <cstdlib>
+#include <algorithm>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+
+//---------------------------------------------------------------------------//
+//                          Allocation Tracker Class                         //
+//---------------------------------------------------------------------------//
+
+/**
+ * The statistics the allocations of the calling thread are counted in or <code>nullptr</code>.
+ */
+static thread_local FAllocationStats *CURRENT_STATS = nullptr;
+/**
+ * The phase the allocations of the calling thread are attributed to.
+ */
+static thread_local FAllocationPhase CURRENT_PHASE = ALLOCATION_PHASE_OTHER;
+/**
+ * Whether every tick that allocated is printed.
+ */
+static std::atomic_bool TRACING(false);
+
+/**
+ * Increments a counter that is only written by the calling thread without a locked read-modify-write.
+ */
+static inline void increment(std::atomic_ulong &counter, const unsigned long value)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void FAllocationTracker::attach(FAllocationStats *stats)
+{
+	CURRENT_STATS = stats;
+	CURRENT_PHASE = ALLOCATION_PHASE_OTHER;
+}
+
+void FAllocationTracker::setPhase(const FAllocationPhase phase)
+{
+	CURRENT_PHASE = phase;
+}
+
+void FAllocationTracker::endTick(const std::string &name, const unsigned long tick)
+{
+	FAllocationStats *stats = CURRENT_STATS;
+	if (stats == nullptr)
+		return;
+
+	unsigned long allocations[ALLOCATION_PHASE_COUNT];
+	unsigned long total = 0;
+	for (int phase = ALLOCATION_PHASE_TASKS; phase < ALLOCATION_PHASE_COUNT; phase++)
+	{
+		unsigned long current = stats->phases[phase].allocations.load(std::memory_order_relaxed);
+		allocations[phase] = current - stats->tickStart[phase];
+		stats->tickStart[phase] = current;
+		total += allocations[phase];
+	}
+
+	if (total == 0)
+		return;
+
+	increment(stats->allocatingTicks, 1);
+	if (total > stats->maxTickAllocations.load(std::memory_order_relaxed))
+		stats->maxTickAllocations.store(total, std::memory_order_relaxed);
+
+	if (TRACING.load(std::memory_order_relaxed))
+	{
+		// the trace itself allocates outside of the tick phases and is therefore not counted in the next tick
+		FLogger::trace(name, "tick {} allocated {} times (tasks: {}, channels: {}, tick: {})", tick, total,
+				allocations[ALLOCATION_PHASE_TASKS], allocations[ALLOCATION_PHASE_CHANNELS], allocations[ALLOCATION_PHASE_TICK]);
+	}
+}
+
+void FAllocationTracker::setTracing(const bool tracing)
+{
+	TRACING = tracing;
+}
+
+void FAllocationTracker::recordAllocation(const size_t size)
+{
+	FAllocationStats *stats = CURRENT_STATS;
+	if (stats == nullptr)
+		return;
+
+	FAllocationCounters &counters = stats->phases[CURRENT_PHASE];
+	increment(counters.allocations, 1);
+	increment(counters.bytes, size);
+}
+
+void FAllocationTracker::recordDeallocation()
+{
+	FAllocationStats *stats = CURRENT_STATS;
+	if (stats == nullptr)
+		return;
+
+	increment(stats->phases[CURRENT_PHASE].deallocations, 1);
+}
+
+
+//---------------------------------------------------------------------------//
+//                         Global Allocation Functions                       //
+//---------------------------------------------------------------------------//
+
+static void *allocate(const size_t size)
+{
+	void *pointer = std::malloc(size == 0 ? 1 : size);
+	if (pointer != nullptr)
+		FAllocationTracker::recordAllocation(size);
+	return pointer;
+}
+
+static void *allocateAligned(const size_t size, const std::align_val_t alignment)
+{
+#ifdef _WIN32
+	void *pointer = _aligned_malloc(size == 0 ? 1 : size, static_cast<size_t>(alignment));
+#else
+	void *pointer = nullptr;
+	if (posix_memalign(&pointer, std::max(static_cast<size_t>(alignment), sizeof(void *)), size == 0 ? 1 : size) != 0)
+		pointer = nullptr;
+#endif
+	if (pointer != nullptr)
+		FAllocationTracker::recordAllocation(size);
+	return pointer;
+}
+
+static void release(void *pointer)
+{
+	if (pointer == nullptr)
+		return;
+
+	FAllocationTracker::recordDeallocation();
+	std::free(pointer);
+}
+
+static void releaseAligned(void *pointer)
+{
+	if (pointer == nullptr)
+		return;
+
+	FAllocationTracker::recordDeallocation();
+#ifdef _WIN32
+	_aligned_free(pointer);
+#else
+	std::free(pointer);
+#endif
+}
+
+void *operator new(const size_t size)
+{
+	void *pointer = allocate(size);
+	if (pointer == nullptr)
+		throw std::bad_alloc();
+	return pointer;
+}
+
+void *operator new[](const size_t size)
+{
+	void *pointer = allocate(size);
+	if (pointer == nullptr)
+		throw std::bad_alloc();
+	return pointer;
+}
+
+void *operator new(const size_t size, const std::nothrow_t &) noexcept
+{
+	return allocate(size);
+}
+
+void *operator new[](const size_t size, const std::nothrow_t &) noexcept
+{
+	return allocate(size);
+}
+
+void *operator new(const size_t size, const std::align_val_t alignment)
+{
+	void *pointer = allocateAligned(size, alignment);
+	if (pointer == nullptr)
+		throw std::bad_alloc();
+	return pointer;
+}
+
+void *operator new[](const size_t size, const std::align_val_t alignment)
+{
+	void *pointer = allocateAligned(size, alignment);
+	if (pointer == nullptr)
+		throw std::bad_alloc();
+	return pointer;
+}
+
+void *operator new(const size_t size, const std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+	return allocateAligned(size, alignment);
+}
+
+void *operator new[](const size_t size, const std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+	return allocateAligned(size, alignment);
+}
+
+void operator delete(void *pointer) noexcept
+{
+	release(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+	release(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+	release(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+	release(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+	release(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+	release(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+	releaseAligned(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept
+{
+	releaseAligned(pointer);
+}
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept
+{
+	releaseAligned(pointer);
+}
+
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept
+{
+	releaseAligned(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t &) noexcept
+{
+	releaseAligned(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t &) noexcept
+{
+	releaseAligned(pointer);
+}
+#endif
+
+const char *FAllocationTracker::getPhaseName(const FAllocationPhase phase)
+{
+	switch (phase)
+	{
+		case ALLOCATION_PHASE_TASKS:
+			return "tasks";
+		case ALLOCATION_PHASE_CHANNELS:
+			return "channels";
+		case ALLOCATION_PHASE_TICK:
+			return "tick";
+		default:
+			return "other";
+	}
+}
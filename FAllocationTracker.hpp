@@ -0,0 +1,184 @@
+/*
+ * FAllocationTracker.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FALLOCATIONTRACKER_HPP_
+#define CORE_CONCURRENT_FALLOCATIONTRACKER_HPP_
+
+#include <string>
+#include <atomic>
+
+/**
+ * Enum defining the phase of an FThread heap allocations are attributed to.
+ */
+enum FAllocationPhase
+{
+	/**
+	 * Everything outside of a tick, e.g. onStart(), onStop() and sleeping.
+	 */
+	ALLOCATION_PHASE_OTHER,
+	/**
+	 * Executing the task queue.
+	 */
+	ALLOCATION_PHASE_TASKS,
+	/**
+	 * Draining the channels.
+	 */
+	ALLOCATION_PHASE_CHANNELS,
+	/**
+	 * The onTick() method.
+	 */
+	ALLOCATION_PHASE_TICK,
+	/**
+	 * The number of phases.
+	 */
+	ALLOCATION_PHASE_COUNT
+};
+
+/**
+ * Heap allocation counters of one phase.
+ */
+struct FAllocationCounters
+{
+	/**
+	 * The number of allocations.
+	 */
+	std::atomic_ulong allocations{0};
+	/**
+	 * The number of deallocations.
+	 */
+	std::atomic_ulong deallocations{0};
+	/**
+	 * The number of bytes allocated.
+	 */
+	std::atomic_ulong bytes{0};
+};
+
+/**
+ * Heap allocation statistics of an FThread.
+ *
+ * <p>Only written by the FThread itself, so the counters can be read at any time without locking.</p>
+ */
+struct FAllocationStats
+{
+	/**
+	 * The counters of every {@link FAllocationPhase}.
+	 */
+	FAllocationCounters phases[ALLOCATION_PHASE_COUNT];
+	/**
+	 * The number of ticks that allocated at least once.
+	 */
+	std::atomic_ulong allocatingTicks{0};
+	/**
+	 * The highest number of allocations within one tick.
+	 */
+	std::atomic_ulong maxTickAllocations{0};
+	/**
+	 * The allocations of every phase when the current tick began.
+	 */
+	unsigned long tickStart[ALLOCATION_PHASE_COUNT] = {};
+
+	/**
+	 * Gets the number of allocations within ticks, that is every phase except {@link ALLOCATION_PHASE_OTHER}.
+	 *
+	 * @return the number of allocations within ticks.
+	 */
+	[[nodiscard]] unsigned long getTickAllocations() const
+	{
+		return this->phases[ALLOCATION_PHASE_TASKS].allocations + this->phases[ALLOCATION_PHASE_CHANNELS].allocations
+			   + this->phases[ALLOCATION_PHASE_TICK].allocations;
+	}
+};
+
+/**
+ * Class counting the heap allocations of FThreads per tick phase.
+ *
+ * <p>Tracking replaces the global operator new and delete and is only compiled in when <code>FTHREAD_TRACK_ALLOCATIONS</code>
+ * is defined, otherwise every method is empty and the counters stay zero. Allocations of threads that are not FThreads
+ * are not counted.</p>
+ */
+class FAllocationTracker
+{
+public:
+
+#ifdef FTHREAD_TRACK_ALLOCATIONS
+	/**
+	 * Whether allocations are tracked.
+	 */
+	static constexpr bool ENABLED = true;
+
+	/**
+	 * Sets the statistics the allocations of the calling thread are counted in.
+	 *
+	 * @param stats A pointer to the statistics or <code>nullptr</code> to stop counting.
+	 */
+	static void attach(FAllocationStats *stats);
+
+	/**
+	 * Sets the phase the following allocations of the calling thread are attributed to.
+	 *
+	 * @param phase The current {@link FAllocationPhase}.
+	 */
+	static void setPhase(FAllocationPhase phase);
+
+	/**
+	 * Finishes a tick of the calling thread and prints its allocations if tracing is enabled.
+	 *
+	 * @param name A reference to the name of the FThread.
+	 * @param tick The number of the finished tick.
+	 */
+	static void endTick(const std::string &name, unsigned long tick);
+
+	/**
+	 * Sets whether every tick that allocated is printed.
+	 *
+	 * @param tracing <code>true</code> to print a line for every allocating tick.
+	 */
+	static void setTracing(bool tracing);
+
+	/**
+	 * Counts an allocation of the calling thread.
+	 *
+	 * @param size The size of the allocation in bytes.
+	 */
+	static void recordAllocation(size_t size);
+
+	/**
+	 * Counts a deallocation of the calling thread.
+	 */
+	static void recordDeallocation();
+#else
+	static constexpr bool ENABLED = false;
+
+	static void attach(FAllocationStats *)
+	{
+	}
+
+	static void setPhase(FAllocationPhase)
+	{
+	}
+
+	static void endTick(const std::string &, unsigned long)
+	{
+	}
+
+	static void setTracing(bool)
+	{
+	}
+#endif
+
+	/**
+	 * Gets the name of the given phase.
+	 *
+	 * @param phase The {@link FAllocationPhase}.
+	 *
+	 * @return the name of the phase.
+	 */
+	static const char *getPhaseName(FAllocationPhase phase);
+};
+
+
+#endif /* CORE_CONCURRENT_FALLOCATIONTRACKER_HPP_ */
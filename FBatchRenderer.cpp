@@ -0,0 +1,271 @@
+/*
+ * FBatchRenderer.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FBatchRenderer.hpp"
+#include "FLogger.hpp"
+
+#include <cstring>
+
+
+//---------------------------------------------------------------------------//
+//                            Batch Renderer Class                           //
+//---------------------------------------------------------------------------//
+
+FBatchRenderer::FBatchRenderer(const size_t maxInstances, const bool multiDrawIndirect, const size_t maxCommands,
+		FGLState *glState)
+		: m_instanceBuffer(GL_ARRAY_BUFFER, maxInstances * sizeof(FInstance)),
+		  m_commandBuffer(GL_DRAW_INDIRECT_BUFFER, maxCommands * sizeof(DrawCommand))
+{
+	this->m_maxInstances = maxInstances;
+	this->m_glState = glState != nullptr ? glState : new FGLState();
+	this->m_ownsGLState = glState == nullptr;
+	this->m_multiDrawIndirectRequested = multiDrawIndirect;
+	this->m_multiDrawIndirect = false;
+	this->m_baseInstance = false;
+	this->m_vertices = std::vector<float>();
+	this->m_meshes = std::vector<Mesh>();
+	this->m_meshesChanged = false;
+	this->m_vertexBuffer = 0;
+	this->m_vertexArray = 0;
+	this->m_batches = std::vector<Batch>();
+	this->m_lastBatch = 0;
+	this->m_instanceCount = 0;
+	this->m_commands = std::vector<DrawCommand>();
+	this->m_drawCalls = 0;
+	this->m_drawnInstances = 0;
+}
+
+FBatchRenderer::~FBatchRenderer()
+{
+	if (this->m_vertexBuffer != 0)
+		FLogger::warning("FBatchRenderer", "destroyed without deleting vertex buffer {}", this->m_vertexBuffer);
+	if (this->m_ownsGLState)
+		delete this->m_glState;
+}
+
+bool FBatchRenderer::create()
+{
+	// the base instance of an indirect command is only read since OpenGL 4.2, multi draw indirect needs 4.3
+	this->m_baseInstance = GLAD_GL_VERSION_4_2;
+	this->m_multiDrawIndirect = this->m_multiDrawIndirectRequested && GLAD_GL_VERSION_4_3;
+
+	bool created = this->m_instanceBuffer.create() && (!this->m_multiDrawIndirect || this->m_commandBuffer.create());
+	// the stream buffers bind their buffers themselves
+	this->m_glState->invalidateBuffers();
+	if (!created)
+	{
+		this->m_instanceBuffer.destroy();
+		return false;
+	}
+
+	glGenBuffers(1, &this->m_vertexBuffer);
+	this->m_meshesChanged = true;
+
+	glGenVertexArrays(1, &this->m_vertexArray);
+	this->m_glState->bindVertexArray(this->m_vertexArray);
+
+	this->m_glState->bindBuffer(GL_ARRAY_BUFFER, this->m_vertexBuffer);
+	glVertexAttribPointer(0, 2, GL_FLOAT, false, sizeof(float) * 5, (const void *) 0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, false, sizeof(float) * 5, (const void *) (sizeof(float) * 2));
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+
+	// the instance attributes advance once per instance, their pointers are set every frame
+	glVertexAttribDivisor(2, 1);
+	glVertexAttribDivisor(3, 1);
+	glEnableVertexAttribArray(2);
+	glEnableVertexAttribArray(3);
+	return true;
+}
+
+void FBatchRenderer::destroy()
+{
+	if (this->m_vertexBuffer == 0)
+		return;
+
+	glDeleteVertexArrays(1, &this->m_vertexArray);
+	glDeleteBuffers(1, &this->m_vertexBuffer);
+	this->m_vertexArray = 0;
+	this->m_vertexBuffer = 0;
+	this->m_instanceBuffer.destroy();
+	this->m_commandBuffer.destroy();
+
+	// deleting bound objects unbinds them
+	this->m_glState->invalidate();
+}
+
+unsigned int FBatchRenderer::addMesh(const std::vector<float> &vertices)
+{
+	Mesh mesh = {static_cast<GLint>(this->m_vertices.size() / 5), static_cast<GLsizei>(vertices.size() / 5)};
+	this->m_vertices.insert(this->m_vertices.end(), vertices.begin(), vertices.end());
+	this->m_meshes.push_back(mesh);
+	this->m_meshesChanged = true;
+	return static_cast<unsigned int>(this->m_meshes.size() - 1);
+}
+
+bool FBatchRenderer::draw(const uint32_t program, const unsigned int mesh, const FInstance &instance)
+{
+	if (mesh >= this->m_meshes.size() || this->m_instanceCount >= this->m_maxInstances)
+		return false;
+
+	// consecutive objects mostly share their program, so the batch is only searched when it changes
+	if (this->m_lastBatch >= this->m_batches.size() || this->m_batches[this->m_lastBatch].program != program)
+	{
+		this->m_lastBatch = 0;
+		while (this->m_lastBatch < this->m_batches.size() && this->m_batches[this->m_lastBatch].program != program)
+			this->m_lastBatch++;
+		if (this->m_lastBatch == this->m_batches.size())
+			this->m_batches.push_back({program, std::vector<std::vector<FInstance>>(), 0, 0});
+	}
+
+	Batch &batch = this->m_batches[this->m_lastBatch];
+	if (batch.instances.size() <= mesh)
+		batch.instances.resize(this->m_meshes.size());
+	batch.instances[mesh].push_back(instance);
+	this->m_instanceCount++;
+	return true;
+}
+
+void FBatchRenderer::setInstanceOffset(const size_t offset)
+{
+	this->m_glState->bindBuffer(GL_ARRAY_BUFFER, this->m_instanceBuffer.getBuffer());
+	glVertexAttribPointer(2, 3, GL_FLOAT, false, sizeof(FInstance), reinterpret_cast<const void *>(offset));
+	glVertexAttribPointer(3, 3, GL_FLOAT, false, sizeof(FInstance), reinterpret_cast<const void *>(offset + sizeof(float) * 3));
+}
+
+void FBatchRenderer::end()
+{
+	if (this->m_vertexBuffer == 0)
+		return;
+
+	if (this->m_meshesChanged)
+	{
+		this->m_glState->bindBuffer(GL_ARRAY_BUFFER, this->m_vertexBuffer);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(this->m_vertices.size() * sizeof(float)), this->m_vertices.data(),
+				GL_STATIC_DRAW);
+		this->m_meshesChanged = false;
+	}
+
+	this->m_drawCalls = 0;
+	this->m_drawnInstances = 0;
+	if (this->m_instanceCount == 0)
+		return;
+
+	// the instances of a group follow each other, so a group is selected by the index of its first instance
+	size_t instanceOffset = 0;
+	FInstance *instances = nullptr;
+	if (this->m_instanceBuffer.beginFrame())
+		instances = static_cast<FInstance *>(this->m_instanceBuffer.allocate(this->m_instanceCount * sizeof(FInstance),
+				sizeof(FInstance), instanceOffset));
+
+	this->m_commands.clear();
+	GLuint baseInstance = 0;
+	for (Batch &batch : this->m_batches)
+	{
+		batch.firstCommand = this->m_commands.size();
+		for (size_t n = 0; n < batch.instances.size(); n++)
+		{
+			std::vector<FInstance> &meshInstances = batch.instances[n];
+			if (meshInstances.empty())
+				continue;
+
+			if (instances != nullptr)
+				std::memcpy(instances + baseInstance, meshInstances.data(), meshInstances.size() * sizeof(FInstance));
+			this->m_commands.push_back({static_cast<GLuint>(this->m_meshes[n].count), static_cast<GLuint>(meshInstances.size()),
+					static_cast<GLuint>(this->m_meshes[n].first), baseInstance});
+			baseInstance += static_cast<GLuint>(meshInstances.size());
+			meshInstances.clear();
+		}
+		batch.commandCount = this->m_commands.size() - batch.firstCommand;
+	}
+	this->m_instanceCount = 0;
+	this->m_instanceBuffer.flush();
+
+	if (instances == nullptr)
+	{
+		FLogger::error("FBatchRenderer", "could not map the instances of the frame!");
+		this->m_instanceBuffer.endFrame();
+		this->m_glState->invalidateBuffers();
+		return;
+	}
+
+	size_t commandOffset = 0;
+	bool indirect = false;
+	if (this->m_multiDrawIndirect && this->m_commandBuffer.beginFrame())
+	{
+		void *commands = this->m_commandBuffer.allocate(this->m_commands.size() * sizeof(DrawCommand), sizeof(DrawCommand),
+				commandOffset);
+		if (commands != nullptr)
+		{
+			std::memcpy(commands, this->m_commands.data(), this->m_commands.size() * sizeof(DrawCommand));
+			indirect = true;
+		}
+		this->m_commandBuffer.flush();
+	}
+	// stream buffers that are not mapped persistently bind their buffers themselves
+	if (!this->m_instanceBuffer.isPersistent())
+		this->m_glState->invalidateBuffers();
+
+	this->m_glState->bindVertexArray(this->m_vertexArray);
+	if (indirect || this->m_baseInstance)
+		this->setInstanceOffset(instanceOffset);
+	if (indirect)
+		this->m_glState->bindBuffer(GL_DRAW_INDIRECT_BUFFER, this->m_commandBuffer.getBuffer());
+
+	for (const Batch &batch : this->m_batches)
+	{
+		if (batch.commandCount == 0)
+			continue;
+
+		this->m_glState->useProgram(batch.program);
+		if (indirect)
+		{
+			glMultiDrawArraysIndirect(GL_TRIANGLES, reinterpret_cast<const void *>(commandOffset + batch.firstCommand * sizeof(DrawCommand)),
+					static_cast<GLsizei>(batch.commandCount), 0);
+			this->m_drawCalls++;
+			continue;
+		}
+
+		for (size_t n = batch.firstCommand; n < batch.firstCommand + batch.commandCount; n++)
+		{
+			const DrawCommand &command = this->m_commands[n];
+			if (this->m_baseInstance)
+			{
+				glDrawArraysInstancedBaseInstance(GL_TRIANGLES, static_cast<GLint>(command.first), static_cast<GLsizei>(command.count),
+						static_cast<GLsizei>(command.instanceCount), command.baseInstance);
+			}
+			else
+			{
+				// OpenGL 3.3 always starts at the first instance, so the attributes are moved to the group instead
+				this->setInstanceOffset(instanceOffset + command.baseInstance * sizeof(FInstance));
+				glDrawArraysInstanced(GL_TRIANGLES, static_cast<GLint>(command.first), static_cast<GLsizei>(command.count),
+						static_cast<GLsizei>(command.instanceCount));
+			}
+			this->m_drawCalls++;
+		}
+	}
+	this->m_drawnInstances = baseInstance;
+
+	this->m_instanceBuffer.endFrame();
+	if (this->m_multiDrawIndirect)
+		this->m_commandBuffer.endFrame();
+}
+
+bool FBatchRenderer::isMultiDrawIndirect() const
+{
+	return this->m_multiDrawIndirect;
+}
+
+unsigned long FBatchRenderer::getDrawCalls() const
+{
+	return this->m_drawCalls;
+}
+
+unsigned long FBatchRenderer::getDrawnInstances() const
+{
+	return this->m_drawnInstances;
+}
@@ -0,0 +1,248 @@
+/*
+ * FBatchRenderer.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FBATCHRENDERER_HPP_
+#define CORE_CONCURRENT_FBATCHRENDERER_HPP_
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "FStreamBuffer.hpp"
+#include "FGLState.hpp"
+#include "glad/glad.h"
+
+/**
+ * The per-instance data of an object drawn by the {@link FBatchRenderer}.
+ *
+ * <p>The vertex shader receives the position and the scale at location 2 and the color at location 3.</p>
+ */
+struct FInstance
+{
+	float x;
+	float y;
+	float scale;
+	float red;
+	float green;
+	float blue;
+};
+
+/**
+ * Class drawing many objects with few draw calls.
+ *
+ * <p>The vertices of all meshes are packed into a single vertex buffer, interleaved as two position and three color
+ * components like the models of an {@link FWindow}. Objects are submitted during a frame with {@link #draw()} and grouped
+ * by their program and mesh. {@link #end()} writes the instances of all objects into an {@link FStreamBuffer} and draws
+ * every group with a single <code>glDrawArraysInstanced</code>. With OpenGL 4.3 all groups of a program are drawn with a
+ * single <code>glMultiDrawArraysIndirect</code> instead, whose commands are streamed as well, so a frame issues one draw
+ * call per program regardless of the number of objects and meshes. Objects of a group keep the order they were submitted
+ * in, but overlapping objects of different groups may be drawn in another order.</p>
+ *
+ * <p>State changes go through the {@link FGLState} of the context, so a frame drawing the same programs as the last one
+ * issues no redundant binds. The batch renderer belongs to the context that created it and must only be used by the
+ * FThread rendering with that context.</p>
+ */
+class FBatchRenderer
+{
+private:
+
+	/**
+	 * A mesh in the vertex buffer.
+	 */
+	struct Mesh
+	{
+		GLint first;
+		GLsizei count;
+	};
+
+	/**
+	 * The objects of a frame drawn with the same program, by their mesh.
+	 */
+	struct Batch
+	{
+		uint32_t program;
+		std::vector<std::vector<FInstance>> instances;
+		size_t firstCommand;
+		size_t commandCount;
+	};
+
+	/**
+	 * A draw command read by <code>glMultiDrawArraysIndirect</code>.
+	 */
+	struct DrawCommand
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint first;
+		GLuint baseInstance;
+	};
+
+	/**
+	 * The maximum number of objects drawn per frame.
+	 */
+	size_t m_maxInstances;
+	/**
+	 * The state of the context of the renderer.
+	 */
+	FGLState *m_glState;
+	/**
+	 * Whether the state has been created by the renderer for itself.
+	 */
+	bool m_ownsGLState;
+	/**
+	 * Whether multi draw indirect should be used if the context supports it.
+	 */
+	bool m_multiDrawIndirectRequested;
+	/**
+	 * Whether the groups of a program are drawn by a single indirect draw call.
+	 */
+	bool m_multiDrawIndirect;
+	/**
+	 * Whether the instances of a group can be selected by a base instance instead of their attribute offsets.
+	 */
+	bool m_baseInstance;
+	/**
+	 * The vertices of all meshes.
+	 */
+	std::vector<float> m_vertices;
+	/**
+	 * The meshes by their index.
+	 */
+	std::vector<Mesh> m_meshes;
+	/**
+	 * Whether meshes were added since the vertex buffer was uploaded.
+	 */
+	bool m_meshesChanged;
+	/**
+	 * The name of the vertex buffer holding the meshes, 0 while the renderer is not created.
+	 */
+	uint32_t m_vertexBuffer;
+	/**
+	 * The name of the vertex array object.
+	 */
+	uint32_t m_vertexArray;
+	/**
+	 * The stream buffer the instances are written into every frame.
+	 */
+	FStreamBuffer m_instanceBuffer;
+	/**
+	 * The stream buffer the draw commands are written into every frame.
+	 */
+	FStreamBuffer m_commandBuffer;
+	/**
+	 * The batches of the current frame, kept between frames to reuse their memory.
+	 */
+	std::vector<Batch> m_batches;
+	/**
+	 * The batch the last object was submitted to.
+	 */
+	size_t m_lastBatch;
+	/**
+	 * The number of objects submitted during the current frame.
+	 */
+	size_t m_instanceCount;
+	/**
+	 * The draw commands of the current frame.
+	 */
+	std::vector<DrawCommand> m_commands;
+	/**
+	 * The number of draw calls issued by the last frame.
+	 */
+	unsigned long m_drawCalls;
+	/**
+	 * The number of objects drawn by the last frame.
+	 */
+	unsigned long m_drawnInstances;
+
+	/**
+	 * Points the instance attributes of the vertex array object at the given offset in the instance buffer.
+	 *
+	 * @param offset The offset of the first instance in bytes.
+	 */
+	void setInstanceOffset(size_t offset);
+
+public:
+
+	/**
+	 * Constructs a new FBatchRenderer, the GL objects are created by {@link #create()}.
+	 *
+	 * @param maxInstances The maximum number of objects drawn per frame.
+	 * @param multiDrawIndirect Whether to draw with <code>glMultiDrawArraysIndirect</code> if the context supports it.
+	 * @param maxCommands The maximum number of groups per frame drawn indirectly, frames with more groups fall back to
+	 * 		instanced draw calls.
+	 * @param glState A pointer to the state of the context shared with the other code drawing into it, must outlive the
+	 * 		renderer. The renderer tracks the state on its own if it is <code>nullptr</code>.
+	 */
+	explicit FBatchRenderer(size_t maxInstances, bool multiDrawIndirect = true, size_t maxCommands = 256,
+			FGLState *glState = nullptr);
+
+	/**
+	 * Destroys the FBatchRenderer, {@link #destroy()} must have been called in its context before.
+	 */
+	~FBatchRenderer();
+
+	/**
+	 * Creates the GL objects in the current context.
+	 *
+	 * @return <code>false</code> if the stream buffers could not be created.
+	 */
+	bool create();
+
+	/**
+	 * Deletes the GL objects in the current context.
+	 */
+	void destroy();
+
+	/**
+	 * Adds a mesh to the vertex buffer, uploaded by the next {@link #end()}.
+	 *
+	 * @param vertices A reference to the vertices, two position and three color components each.
+	 * @return the index of the mesh.
+	 */
+	unsigned int addMesh(const std::vector<float> &vertices);
+
+	/**
+	 * Submits an object to the current frame.
+	 *
+	 * @param program The name of the program, its vertex shader must read the instance attributes of {@link FInstance}.
+	 * @param mesh The index of the mesh.
+	 * @param instance A reference to the instance data of the object.
+	 * @return <code>false</code> if the frame is full or the mesh does not exist.
+	 */
+	bool draw(uint32_t program, unsigned int mesh, const FInstance &instance);
+
+	/**
+	 * Draws the objects submitted since the last frame and begins the next one.
+	 *
+	 * <p>Leaves the vertex array object and the program of the last objects bound.</p>
+	 */
+	void end();
+
+	/**
+	 * Gets whether the groups of a program are drawn by a single indirect draw call.
+	 *
+	 * @return <code>true</code> if <code>glMultiDrawArraysIndirect</code> is used.
+	 */
+	[[nodiscard]] bool isMultiDrawIndirect() const;
+
+	/**
+	 * Gets the number of draw calls issued by the last frame.
+	 *
+	 * @return the number of draw calls.
+	 */
+	[[nodiscard]] unsigned long getDrawCalls() const;
+
+	/**
+	 * Gets the number of objects drawn by the last frame.
+	 *
+	 * @return the number of objects.
+	 */
+	[[nodiscard]] unsigned long getDrawnInstances() const;
+};
+
+
+#endif /* CORE_CONCURRENT_FBATCHRENDERER_HPP_ */
@@ -0,0 +1,550 @@
+/*
+ * FChannel.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FCHANNEL_HPP_
+#define CORE_CONCURRENT_FCHANNEL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+
+#include "FThread.hpp"
+
+/**
+ * Base class of all channels an FThread can drain in its main loop.
+ */
+class FChannelBase
+{
+protected:
+
+	/**
+	 * A pointer to the FThread that drains the channel or <code>nullptr</code>.
+	 */
+	FThread *m_consumer = nullptr;
+	/**
+	 * Whether the consumer is woken up when messages are pushed.
+	 */
+	bool m_wakeConsumer = false;
+
+	/**
+	 * Wakes up the consumer if the channel was connected with <code>wakeConsumer</code>.
+	 */
+	void notifyConsumer()
+	{
+		if (this->m_wakeConsumer)
+			this->m_consumer->wake();
+	}
+
+public:
+
+	/**
+	 * Destroys the channel.
+	 */
+	virtual ~FChannelBase() = default;
+
+	/**
+	 * Passes every message that is in the channel right now to the handler of the channel.
+	 *
+	 * <p>Must only be called by the consumer.</p>
+	 *
+	 * @return the number of drained messages.
+	 */
+	virtual size_t drain() = 0;
+};
+
+/**
+ * Bounded single producer single consumer channel.
+ *
+ * <p>The messages are stored in a ring of default constructed slots. Push and pop are wait-free, the producer and
+ * the consumer each own one index on its own cache line and only read the index of the other side when their
+ * cached copy says the ring is full or empty.</p>
+ *
+ * @tparam T The type of the messages. Must be default constructible and move assignable.
+ */
+template<typename T>
+class FSPSCChannel : public FChannelBase
+{
+private:
+
+	/**
+	 * The slots of the ring.
+	 */
+	T *m_slots;
+	/**
+	 * The number of slots minus one.
+	 */
+	size_t m_mask;
+	/**
+	 * The handler the messages are passed to by {@link #drain()}.
+	 */
+	std::function<void(T *, size_t)> m_handler;
+	/**
+	 * The position of the next message the consumer pops.
+	 */
+	alignas(CACHE_LINE_SIZE) std::atomic_size_t m_head;
+	/**
+	 * The last {@link #m_tail} the consumer has seen.
+	 */
+	size_t m_cachedTail;
+	/**
+	 * The position of the next message the producer pushes.
+	 */
+	alignas(CACHE_LINE_SIZE) std::atomic_size_t m_tail;
+	/**
+	 * The last {@link #m_head} the producer has seen.
+	 */
+	size_t m_cachedHead;
+	/**
+	 * Padding so objects following the channel do not share the cache line of the producer.
+	 */
+	char m_padding[CACHE_LINE_SIZE - sizeof(std::atomic_size_t) - sizeof(size_t)];
+
+	/**
+	 * Gets the number of slots the producer can write without checking the consumer again.
+	 */
+	size_t getFreeSlots(const size_t tail)
+	{
+		size_t capacity = this->m_mask + 1;
+		if (tail - this->m_cachedHead >= capacity)
+			this->m_cachedHead = this->m_head.load(std::memory_order_acquire);
+		return capacity - (tail - this->m_cachedHead);
+	}
+
+	/**
+	 * Gets the number of messages the consumer can read without checking the producer again.
+	 */
+	size_t getUsedSlots(const size_t head)
+	{
+		if (this->m_cachedTail == head)
+			this->m_cachedTail = this->m_tail.load(std::memory_order_acquire);
+		return this->m_cachedTail - head;
+	}
+
+public:
+
+	/**
+	 * Constructs a new FSPSCChannel.
+	 *
+	 * @param capacity The minimum number of messages the channel can hold. Rounded up to the next power of two.
+	 */
+	explicit FSPSCChannel(const size_t capacity)
+	{
+		size_t slots = 2;
+		while (slots < capacity)
+			slots <<= 1u;
+
+		this->m_slots = new T[slots];
+		this->m_mask = slots - 1;
+		this->m_head = 0;
+		this->m_cachedTail = 0;
+		this->m_tail = 0;
+		this->m_cachedHead = 0;
+	}
+
+	FSPSCChannel(const FSPSCChannel &) = delete;
+
+	FSPSCChannel &operator=(const FSPSCChannel &) = delete;
+
+	~FSPSCChannel() override
+	{
+		delete[] this->m_slots;
+	}
+
+	/**
+	 * Connects the channel to the FThread that drains it before every tick.
+	 *
+	 * <p>Must be called before the FThread is started.</p>
+	 *
+	 * @param consumer A pointer to the consuming FThread.
+	 * @param handler The handler contiguous batches of messages are passed to. The messages may be moved from.
+	 * @param wakeConsumer Whether pushing wakes up the consumer. Only useful for {@link TaskQueueMode#QUEUE_ONLY} consumers.
+	 */
+	void connect(FThread *consumer, const std::function<void(T *, size_t)> &handler, const bool wakeConsumer = false)
+	{
+		this->m_consumer = consumer;
+		this->m_handler = handler;
+		this->m_wakeConsumer = wakeConsumer;
+		consumer->addChannel(this);
+	}
+
+	/**
+	 * Pushes a message into the channel.
+	 *
+	 * <p>Must only be called by the producer.</p>
+	 *
+	 * @param message The message that will be pushed.
+	 *
+	 * @return <code>false</code> if the channel is full.
+	 */
+	bool push(T message)
+	{
+		size_t tail = this->m_tail.load(std::memory_order_relaxed);
+		if (this->getFreeSlots(tail) == 0)
+			return false;
+
+		this->m_slots[tail & this->m_mask] = std::move(message);
+		this->m_tail.store(tail + 1, std::memory_order_release);
+		this->notifyConsumer();
+		return true;
+	}
+
+	/**
+	 * Pushes as many of the given messages as fit into the channel.
+	 *
+	 * <p>Must only be called by the producer. The consumer is woken up once for the whole batch.</p>
+	 *
+	 * @param messages A pointer to the messages that will be pushed.
+	 * @param count The number of messages.
+	 *
+	 * @return the number of pushed messages.
+	 */
+	size_t pushBatch(const T *messages, size_t count)
+	{
+		size_t tail = this->m_tail.load(std::memory_order_relaxed);
+		count = std::min(count, this->getFreeSlots(tail));
+		for (size_t n = 0; n < count; n++)
+			this->m_slots[(tail + n) & this->m_mask] = messages[n];
+
+		if (count > 0)
+		{
+			this->m_tail.store(tail + count, std::memory_order_release);
+			this->notifyConsumer();
+		}
+		return count;
+	}
+
+	/**
+	 * Pops a message from the channel.
+	 *
+	 * <p>Must only be called by the consumer.</p>
+	 *
+	 * @param message A reference the message will be moved to.
+	 *
+	 * @return <code>false</code> if the channel is empty.
+	 */
+	bool pop(T &message)
+	{
+		size_t head = this->m_head.load(std::memory_order_relaxed);
+		if (this->getUsedSlots(head) == 0)
+			return false;
+
+		message = std::move(this->m_slots[head & this->m_mask]);
+		this->m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Pops up to the given number of messages from the channel.
+	 *
+	 * <p>Must only be called by the consumer.</p>
+	 *
+	 * @param messages A pointer to the array the messages will be moved to.
+	 * @param maxCount The maximum number of messages that will be popped.
+	 *
+	 * @return the number of popped messages.
+	 */
+	size_t popBatch(T *messages, size_t maxCount)
+	{
+		size_t head = this->m_head.load(std::memory_order_relaxed);
+		size_t count = std::min(maxCount, this->getUsedSlots(head));
+		for (size_t n = 0; n < count; n++)
+			messages[n] = std::move(this->m_slots[(head + n) & this->m_mask]);
+
+		if (count > 0)
+			this->m_head.store(head + count, std::memory_order_release);
+		return count;
+	}
+
+	/**
+	 * Passes the messages to the handler in place without copying them.
+	 *
+	 * @return the number of drained messages.
+	 */
+	size_t drain() override
+	{
+		size_t head = this->m_head.load(std::memory_order_relaxed);
+		size_t count = this->getUsedSlots(head);
+		size_t drained = 0;
+		while (drained < count)
+		{
+			// the messages wrap around at the end of the ring, so they are passed as up to two contiguous batches
+			size_t index = (head + drained) & this->m_mask;
+			size_t batch = std::min(count - drained, this->m_mask + 1 - index);
+			this->m_handler(this->m_slots + index, batch);
+			drained += batch;
+		}
+
+		if (count > 0)
+			this->m_head.store(head + count, std::memory_order_release);
+		return count;
+	}
+};
+
+/**
+ * Bounded multi producer multi consumer channel.
+ *
+ * <p>Every slot carries a sequence number that tells producers and consumers whether the slot is free or filled, so
+ * a push or pop only needs one compare-and-swap on the shared index in the uncontended case. The producer and consumer
+ * indices live on separate cache lines.</p>
+ *
+ * @tparam T The type of the messages. Must be default constructible and move assignable.
+ */
+template<typename T>
+class FMPMCChannel : public FChannelBase
+{
+private:
+
+	/**
+	 * A slot of the channel.
+	 */
+	struct Slot
+	{
+		std::atomic_size_t sequence;
+		T message;
+	};
+
+	/**
+	 * The maximum number of messages passed to the handler at once by {@link #drain()}.
+	 */
+	static constexpr size_t DRAIN_BATCH_SIZE = 64;
+
+	/**
+	 * The slots of the channel.
+	 */
+	Slot *m_slots;
+	/**
+	 * The number of slots minus one.
+	 */
+	size_t m_mask;
+	/**
+	 * The buffer the messages are moved to before they are passed to the handler.
+	 */
+	T *m_drainBuffer;
+	/**
+	 * The handler the messages are passed to by {@link #drain()}.
+	 */
+	std::function<void(T *, size_t)> m_handler;
+	/**
+	 * The position of the next message that will be popped.
+	 */
+	alignas(CACHE_LINE_SIZE) std::atomic_size_t m_head;
+	/**
+	 * The position of the next message that will be pushed.
+	 */
+	alignas(CACHE_LINE_SIZE) std::atomic_size_t m_tail;
+	/**
+	 * Padding so objects following the channel do not share the cache line of the producers.
+	 */
+	char m_padding[CACHE_LINE_SIZE - sizeof(std::atomic_size_t)];
+
+	/**
+	 * Claims the slot for the next push.
+	 *
+	 * @return a pointer to the claimed slot or <code>nullptr</code> if the channel is full.
+	 */
+	Slot *claimPush(size_t &position)
+	{
+		position = this->m_tail.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Slot *slot = &this->m_slots[position & this->m_mask];
+			size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			auto difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+			if (difference == 0)
+			{
+				if (this->m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					return slot;
+			}
+			else if (difference < 0)
+			{
+				return nullptr;
+			}
+			else
+			{
+				position = this->m_tail.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+public:
+
+	/**
+	 * Constructs a new FMPMCChannel.
+	 *
+	 * @param capacity The minimum number of messages the channel can hold. Rounded up to the next power of two.
+	 */
+	explicit FMPMCChannel(const size_t capacity)
+	{
+		size_t slots = 2;
+		while (slots < capacity)
+			slots <<= 1u;
+
+		this->m_slots = new Slot[slots];
+		for (size_t n = 0; n < slots; n++)
+			this->m_slots[n].sequence.store(n, std::memory_order_relaxed);
+
+		this->m_mask = slots - 1;
+		this->m_drainBuffer = new T[DRAIN_BATCH_SIZE];
+		this->m_head = 0;
+		this->m_tail = 0;
+	}
+
+	FMPMCChannel(const FMPMCChannel &) = delete;
+
+	FMPMCChannel &operator=(const FMPMCChannel &) = delete;
+
+	~FMPMCChannel() override
+	{
+		delete[] this->m_slots;
+		delete[] this->m_drainBuffer;
+	}
+
+	/**
+	 * Connects the channel to the FThread that drains it before every tick.
+	 *
+	 * <p>Must be called before the FThread is started. Other consumers can still pop from the channel.</p>
+	 *
+	 * @param consumer A pointer to the consuming FThread.
+	 * @param handler The handler batches of messages are passed to. The messages may be moved from.
+	 * @param wakeConsumer Whether pushing wakes up the consumer. Only useful for {@link TaskQueueMode#QUEUE_ONLY} consumers.
+	 */
+	void connect(FThread *consumer, const std::function<void(T *, size_t)> &handler, const bool wakeConsumer = false)
+	{
+		this->m_consumer = consumer;
+		this->m_handler = handler;
+		this->m_wakeConsumer = wakeConsumer;
+		consumer->addChannel(this);
+	}
+
+	/**
+	 * Pushes a message into the channel.
+	 *
+	 * @param message The message that will be pushed.
+	 *
+	 * @return <code>false</code> if the channel is full.
+	 */
+	bool push(T message)
+	{
+		size_t position;
+		Slot *slot = this->claimPush(position);
+		if (slot == nullptr)
+			return false;
+
+		slot->message = std::move(message);
+		slot->sequence.store(position + 1, std::memory_order_release);
+		this->notifyConsumer();
+		return true;
+	}
+
+	/**
+	 * Pushes as many of the given messages as fit into the channel.
+	 *
+	 * <p>The consumer is woken up once for the whole batch.</p>
+	 *
+	 * @param messages A pointer to the messages that will be pushed.
+	 * @param count The number of messages.
+	 *
+	 * @return the number of pushed messages.
+	 */
+	size_t pushBatch(const T *messages, const size_t count)
+	{
+		size_t pushed = 0;
+		size_t position;
+		while (pushed < count)
+		{
+			Slot *slot = this->claimPush(position);
+			if (slot == nullptr)
+				break;
+
+			slot->message = messages[pushed++];
+			slot->sequence.store(position + 1, std::memory_order_release);
+		}
+
+		if (pushed > 0)
+			this->notifyConsumer();
+		return pushed;
+	}
+
+	/**
+	 * Pops a message from the channel.
+	 *
+	 * @param message A reference the message will be moved to.
+	 *
+	 * @return <code>false</code> if the channel is empty.
+	 */
+	bool pop(T &message)
+	{
+		size_t position = this->m_head.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Slot *slot = &this->m_slots[position & this->m_mask];
+			size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			auto difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position + 1);
+			if (difference == 0)
+			{
+				if (this->m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					message = std::move(slot->message);
+					slot->sequence.store(position + this->m_mask + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (difference < 0)
+			{
+				return false;
+			}
+			else
+			{
+				position = this->m_head.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/**
+	 * Pops up to the given number of messages from the channel.
+	 *
+	 * @param messages A pointer to the array the messages will be moved to.
+	 * @param maxCount The maximum number of messages that will be popped.
+	 *
+	 * @return the number of popped messages.
+	 */
+	size_t popBatch(T *messages, const size_t maxCount)
+	{
+		size_t count = 0;
+		while (count < maxCount && this->pop(messages[count]))
+			count++;
+		return count;
+	}
+
+	/**
+	 * Passes the messages to the handler in batches of up to {@link #DRAIN_BATCH_SIZE} messages.
+	 *
+	 * <p>Only the messages that were in the channel when the drain started are passed to the handler.</p>
+	 *
+	 * @return the number of drained messages.
+	 */
+	size_t drain() override
+	{
+		size_t head = this->m_head.load(std::memory_order_relaxed);
+		size_t available = this->m_tail.load(std::memory_order_acquire) - head;
+		size_t drained = 0;
+		while (drained < available)
+		{
+			size_t count = this->popBatch(this->m_drainBuffer, std::min(DRAIN_BATCH_SIZE, available - drained));
+			if (count == 0)
+				break;
+
+			this->m_handler(this->m_drainBuffer, count);
+			drained += count;
+		}
+		return drained;
+	}
+};
+
+
+#endif /* CORE_CONCURRENT_FCHANNEL_HPP_ */
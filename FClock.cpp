@@ -0,0 +1,190 @@
+/*
+ * FClock.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FClock.hpp"
+#include <algorithm>
+
+
+//---------------------------------------------------------------------------//
+//                                Clock Class                                //
+//---------------------------------------------------------------------------//
+
+constexpr std::chrono::microseconds FClock::FOREVER;
+
+void FClock::attach(FClockSleeper *)
+{
+}
+
+void FClock::detach(FClockSleeper *)
+{
+}
+
+FClock *FClock::getRealClock()
+{
+	static FRealClock *realClock = new FRealClock();
+	return realClock;
+}
+
+
+//---------------------------------------------------------------------------//
+//                              Real Clock Class                             //
+//---------------------------------------------------------------------------//
+
+std::chrono::microseconds FRealClock::now()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
+}
+
+void FRealClock::sleepUntil(FClockSleeper *sleeper, const std::chrono::microseconds &time)
+{
+	std::unique_lock<std::mutex> lock(sleeper->mutex);
+	if (time == FOREVER)
+	{
+		sleeper->condition.wait(lock, [sleeper] { return sleeper->wakeRequested; });
+	}
+	else
+	{
+		std::chrono::time_point<std::chrono::high_resolution_clock> sleepUntil(
+				std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(time));
+		sleeper->condition.wait_until(lock, sleepUntil, [sleeper] { return sleeper->wakeRequested; });
+	}
+	sleeper->wakeRequested = false;
+}
+
+void FRealClock::wake(FClockSleeper *sleeper)
+{
+	sleeper->mutex.lock();
+	sleeper->wakeRequested = true;
+	sleeper->mutex.unlock();
+	sleeper->condition.notify_one();
+}
+
+
+//---------------------------------------------------------------------------//
+//                            Virtual Clock Class                            //
+//---------------------------------------------------------------------------//
+
+FVirtualClock::FVirtualClock(const std::chrono::microseconds &startTime)
+{
+	this->m_now = startTime;
+	this->m_participants = std::vector<FClockSleeper *>();
+	this->m_sleeping = 0;
+	this->m_paused = false;
+}
+
+std::chrono::microseconds FVirtualClock::now()
+{
+	this->m_mutex.lock();
+	std::chrono::microseconds now = this->m_now;
+	this->m_mutex.unlock();
+	return now;
+}
+
+void FVirtualClock::attach(FClockSleeper *sleeper)
+{
+	this->m_mutex.lock();
+	if (std::find(this->m_participants.begin(), this->m_participants.end(), sleeper) == this->m_participants.end())
+		this->m_participants.push_back(sleeper);
+	this->m_mutex.unlock();
+}
+
+void FVirtualClock::detach(FClockSleeper *sleeper)
+{
+	this->m_mutex.lock();
+	auto it = std::find(this->m_participants.begin(), this->m_participants.end(), sleeper);
+	if (it != this->m_participants.end())
+	{
+		this->m_participants.erase(it);
+		if (sleeper->sleeping)
+		{
+			sleeper->sleeping = false;
+			this->m_sleeping--;
+			sleeper->condition.notify_one();
+		}
+
+		// the remaining participants might all be sleeping now
+		this->advance();
+	}
+	this->m_mutex.unlock();
+}
+
+void FVirtualClock::sleepUntil(FClockSleeper *sleeper, const std::chrono::microseconds &time)
+{
+	std::unique_lock<std::mutex> lock(this->m_mutex);
+	if (sleeper->wakeRequested || time <= this->m_now)
+	{
+		sleeper->wakeRequested = false;
+		return;
+	}
+
+	sleeper->deadline = time;
+	sleeper->sleeping = true;
+	this->m_sleeping++;
+	this->advance();
+
+	sleeper->condition.wait(lock, [sleeper] { return !sleeper->sleeping; });
+	sleeper->wakeRequested = false;
+}
+
+void FVirtualClock::wake(FClockSleeper *sleeper)
+{
+	this->m_mutex.lock();
+	if (sleeper->sleeping)
+	{
+		sleeper->sleeping = false;
+		this->m_sleeping--;
+		sleeper->condition.notify_one();
+	}
+	else
+	{
+		sleeper->wakeRequested = true;
+	}
+	this->m_mutex.unlock();
+}
+
+void FVirtualClock::pause()
+{
+	this->m_mutex.lock();
+	this->m_paused = true;
+	this->m_mutex.unlock();
+}
+
+void FVirtualClock::resume()
+{
+	this->m_mutex.lock();
+	this->m_paused = false;
+	this->advance();
+	this->m_mutex.unlock();
+}
+
+void FVirtualClock::advance()
+{
+	if (this->m_paused || this->m_sleeping == 0 || this->m_sleeping < this->m_participants.size())
+		return;
+
+	std::chrono::microseconds earliest = FOREVER;
+	for (FClockSleeper *sleeper : this->m_participants)
+	{
+		if (sleeper->sleeping && sleeper->deadline < earliest)
+			earliest = sleeper->deadline;
+	}
+
+	// every participant waits for something else than the clock
+	if (earliest == FOREVER)
+		return;
+
+	this->m_now = earliest;
+	for (FClockSleeper *sleeper : this->m_participants)
+	{
+		if (sleeper->sleeping && sleeper->deadline <= this->m_now)
+		{
+			sleeper->sleeping = false;
+			this->m_sleeping--;
+			sleeper->condition.notify_one();
+		}
+	}
+}
@@ -0,0 +1,201 @@
+/*
+ * FClock.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FCLOCK_HPP_
+#define CORE_CONCURRENT_FCLOCK_HPP_
+
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+
+/**
+ * Structure a thread sleeps on while it is waiting on an {@link FClock}.
+ */
+struct FClockSleeper
+{
+	/**
+	 * Mutex for the {@link #condition} when sleeping on the real clock.
+	 */
+	std::mutex mutex;
+	/**
+	 * Condition that is notified when the sleeper is woken up.
+	 */
+	std::condition_variable condition;
+	/**
+	 * Whether the sleeper was woken up before it went to sleep.
+	 */
+	bool wakeRequested = false;
+	/**
+	 * Whether the sleeper is currently sleeping on a virtual clock.
+	 */
+	bool sleeping = false;
+	/**
+	 * The time in microseconds the sleeper wants to be woken up at on a virtual clock.
+	 */
+	std::chrono::microseconds deadline = std::chrono::microseconds(0);
+};
+
+/**
+ * Class representing the time source FThreads tick and sleep with.
+ */
+class FClock
+{
+public:
+
+	/**
+	 * Time point meaning the sleeper will only wake up when {@link #wake()} is called.
+	 */
+	static constexpr std::chrono::microseconds FOREVER = std::chrono::microseconds::max();
+
+	/**
+	 * Destroys the clock.
+	 */
+	virtual ~FClock() = default;
+
+	/**
+	 * Gets the current time of the clock.
+	 *
+	 * @return the current time in microseconds.
+	 */
+	virtual std::chrono::microseconds now() = 0;
+
+	/**
+	 * Registers a sleeper as a participant of the clock.
+	 *
+	 * @param sleeper A pointer to the {@link FClockSleeper} of the participant.
+	 */
+	virtual void attach(FClockSleeper *sleeper);
+
+	/**
+	 * Removes a sleeper from the participants of the clock.
+	 *
+	 * @param sleeper A pointer to the {@link FClockSleeper} of the participant.
+	 */
+	virtual void detach(FClockSleeper *sleeper);
+
+	/**
+	 * Sleeps until the given time is reached or the sleeper is woken up by {@link #wake()}.
+	 *
+	 * @param sleeper A pointer to the {@link FClockSleeper} of the calling thread.
+	 * @param time The time in microseconds at which the sleeper wakes up at the latest or {@link #FOREVER}.
+	 */
+	virtual void sleepUntil(FClockSleeper *sleeper, const std::chrono::microseconds &time) = 0;
+
+	/**
+	 * Wakes up the given sleeper.
+	 *
+	 * <p>If the sleeper is not sleeping right now its next call to {@link #sleepUntil()} returns immediately.</p>
+	 *
+	 * @param sleeper A pointer to the {@link FClockSleeper} that will be woken up.
+	 */
+	virtual void wake(FClockSleeper *sleeper) = 0;
+
+	/**
+	 * Gets the clock that follows the wall time.
+	 *
+	 * @return a pointer to the real clock.
+	 */
+	static FClock *getRealClock();
+};
+
+/**
+ * Clock which follows the wall time using the high resolution clock.
+ */
+class FRealClock : public FClock
+{
+public:
+
+	std::chrono::microseconds now() override;
+
+	void sleepUntil(FClockSleeper *sleeper, const std::chrono::microseconds &time) override;
+
+	void wake(FClockSleeper *sleeper) override;
+};
+
+/**
+ * Clock which only advances when every participant is sleeping.
+ *
+ * <p>When the last participant goes to sleep the time jumps to the earliest deadline of all sleepers and those sleepers are woken up.
+ * This way ticks are executed as fast as possible while the order of ticks stays the same as with the real clock.
+ * Participants that wait for something else than the clock, e.g. for their start dependencies, block the clock.</p>
+ *
+ * <p>FThreads only participate once they are started, so the first started FThread would run the clock ahead on its own
+ * until the next one is started. Pausing the clock while starting the FThreads and resuming it afterwards lets all of
+ * them begin at the same time:</p>
+ *
+ * <pre>
+ * clock.pause();
+ * first.start();
+ * second.start();
+ * clock.resume();
+ * </pre>
+ */
+class FVirtualClock : public FClock
+{
+private:
+
+	/**
+	 * Mutex for the time and the participants of the clock.
+	 */
+	std::mutex m_mutex;
+	/**
+	 * The current time of the clock in microseconds.
+	 */
+	std::chrono::microseconds m_now;
+	/**
+	 * A list with pointers to the sleepers participating in the clock.
+	 */
+	std::vector<FClockSleeper *> m_participants;
+	/**
+	 * The number of participants that are currently sleeping.
+	 */
+	unsigned int m_sleeping;
+	/**
+	 * Whether the time is held until {@link #resume()} is called.
+	 */
+	bool m_paused;
+
+	/**
+	 * Advances the time to the earliest deadline if every participant is sleeping.
+	 *
+	 * <p>{@link #m_mutex} must be locked when calling this method.</p>
+	 */
+	void advance();
+
+public:
+
+	/**
+	 * Constructs a new virtual clock.
+	 *
+	 * @param startTime The time in microseconds the clock starts at.
+	 */
+	explicit FVirtualClock(const std::chrono::microseconds &startTime = std::chrono::microseconds(0));
+
+	std::chrono::microseconds now() override;
+
+	void attach(FClockSleeper *sleeper) override;
+
+	void detach(FClockSleeper *sleeper) override;
+
+	void sleepUntil(FClockSleeper *sleeper, const std::chrono::microseconds &time) override;
+
+	void wake(FClockSleeper *sleeper) override;
+
+	/**
+	 * Holds the time, participants keep running until they sleep but are not woken up by the clock.
+	 */
+	void pause();
+
+	/**
+	 * Lets the time advance again, waking up the sleepers whose deadline is reached first if every participant sleeps.
+	 */
+	void resume();
+};
+
+
+#endif /* CORE_CONCURRENT_FCLOCK_HPP_ */
@@ -0,0 +1,498 @@
+/*
+ * FContextGroup.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FContextGroup.hpp"
+#include "FLogger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+
+
+/**
+ * <code>GL_COMPLETION_STATUS_KHR</code> of <code>GL_KHR_parallel_shader_compile</code>, which the GL loader does not
+ * define.
+ */
+static constexpr GLenum COMPLETION_STATUS = 0x91B1;
+
+/**
+ * Guards loading the GL functions, which glad keeps in globals that every context of the process shares. Loading them
+ * again while another thread calls them briefly resets them to <code>nullptr</code>.
+ */
+static std::once_flag GL_LOADED;
+
+/**
+ * Enum defining the state of a program.
+ */
+enum ProgramState
+{
+	/**
+	 * The program waits for the compiler FThread.
+	 */
+	PROGRAM_QUEUED,
+	/**
+	 * The creation of the program has been issued.
+	 */
+	PROGRAM_BUILDING,
+	PROGRAM_READY,
+	PROGRAM_FAILED
+};
+
+struct FContextGroup::Program
+{
+	std::string vertexShaderSource;
+	std::string fragmentShaderSource;
+	/**
+	 * The name of the program, only valid to other contexts once the program is ready.
+	 */
+	uint32_t id;
+	uint32_t vertexShader;
+	uint32_t fragmentShader;
+	/**
+	 * The fence signalled once the commands creating the program have been executed.
+	 */
+	GLsync fence;
+	/**
+	 * Whether the program has been loaded from the program cache.
+	 */
+	bool cached;
+	/**
+	 * Whether every window released the program while the compiler FThread was building it.
+	 */
+	bool released;
+	std::atomic<ProgramState> state;
+	unsigned int references;
+	/**
+	 * The time the creation of the program was issued at.
+	 */
+	std::chrono::time_point<std::chrono::high_resolution_clock> begin;
+};
+
+
+//---------------------------------------------------------------------------//
+//                             Context Group Class                           //
+//---------------------------------------------------------------------------//
+
+FContextGroup::FContextGroup(FProgramCache *programCache)
+{
+	this->m_programCache = programCache;
+	this->m_mutex.setName("FContextGroup::m_mutex");
+	this->m_windows = std::vector<GLFWwindow *>();
+	this->m_parallelCompile = false;
+	this->m_maxShaderCompilerThreads = nullptr;
+	this->m_compiler = nullptr;
+	this->m_compilerThread = nullptr;
+	this->m_compilerWindow = nullptr;
+	this->m_compileQueue = std::vector<Program *>();
+	this->m_programs = std::map<std::pair<std::string, std::string>, Program *>();
+	this->m_buffers = std::map<std::vector<float>, Buffer>();
+}
+
+FContextGroup::~FContextGroup()
+{
+	this->stopCompiler();
+
+	if (!this->m_programs.empty() || !this->m_buffers.empty())
+		FLogger::warning("FContextGroup", "destroyed with {} programs and {} buffers still in use", this->m_programs.size(), this->m_buffers.size());
+}
+
+GLFWwindow *FContextGroup::getShareWindow()
+{
+	std::lock_guard<FMutex> lock(this->m_mutex);
+	return this->m_windows.empty() ? nullptr : this->m_windows.front();
+}
+
+void FContextGroup::addWindow(GLFWwindow *window)
+{
+	this->m_mutex.lock();
+	bool first = this->m_windows.empty();
+	this->m_windows.push_back(window);
+	this->m_mutex.unlock();
+
+	if (first)
+		this->startCompiler(window);
+}
+
+void FContextGroup::removeWindow(GLFWwindow *window)
+{
+	this->m_mutex.lock();
+	this->m_windows.erase(std::remove(this->m_windows.begin(), this->m_windows.end(), window), this->m_windows.end());
+	bool empty = this->m_windows.empty();
+	this->m_mutex.unlock();
+
+	// the windows released their programs before, so the compiler has nothing left to do
+	if (empty)
+		this->stopCompiler();
+}
+
+void FContextGroup::startCompiler(GLFWwindow *window)
+{
+	GLFWwindow *previousContext = glfwGetCurrentContext();
+	glfwMakeContextCurrent(window);
+	// the first window of the first group loads the functions before any FThread renders or compiles with them
+	std::call_once(GL_LOADED, [] { gladLoadGL(); });
+	if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+		this->m_maxShaderCompilerThreads = reinterpret_cast<void (*)(GLuint)>(glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+	else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile"))
+		this->m_maxShaderCompilerThreads = reinterpret_cast<void (*)(GLuint)>(glfwGetProcAddress("glMaxShaderCompilerThreadsARB"));
+	glfwMakeContextCurrent(previousContext);
+
+	this->m_parallelCompile = this->m_maxShaderCompilerThreads != nullptr;
+	if (this->m_parallelCompile)
+		return;
+
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow *compilerWindow = glfwCreateWindow(1, 1, "FContextGroup-Compiler", nullptr, window);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+	if (compilerWindow == nullptr)
+	{
+		FLogger::warning("FContextGroup", "could not create the window of the compiler, compiling programs synchronously");
+		return;
+	}
+
+	auto *compiler = new Compiler(this, compilerWindow);
+	this->m_mutex.lock();
+	this->m_compilerWindow = compilerWindow;
+	this->m_compiler = compiler;
+	this->m_mutex.unlock();
+	this->m_compilerThread = compiler->start();
+}
+
+void FContextGroup::stopCompiler()
+{
+	if (this->m_compiler != nullptr)
+	{
+		this->m_compiler->stop();
+		this->m_compilerThread->join();
+		delete this->m_compilerThread;
+		delete this->m_compiler;
+		glfwDestroyWindow(this->m_compilerWindow);
+
+		this->m_mutex.lock();
+		this->m_compilerThread = nullptr;
+		this->m_compiler = nullptr;
+		this->m_compilerWindow = nullptr;
+		this->m_mutex.unlock();
+	}
+
+	// the next first window decides again
+	this->m_parallelCompile = false;
+	this->m_maxShaderCompilerThreads = nullptr;
+}
+
+FContextGroup::Program *FContextGroup::acquireProgram(const char *vertexShaderSource, const char *fragmentShaderSource)
+{
+	std::lock_guard<FMutex> lock(this->m_mutex);
+
+	auto key = std::make_pair(std::string(vertexShaderSource), std::string(fragmentShaderSource));
+	auto iterator = this->m_programs.find(key);
+	if (iterator != this->m_programs.end())
+	{
+		iterator->second->references++;
+		return iterator->second;
+	}
+
+	auto *program = new Program();
+	program->vertexShaderSource = key.first;
+	program->fragmentShaderSource = key.second;
+	program->id = 0;
+	program->vertexShader = 0;
+	program->fragmentShader = 0;
+	program->fence = nullptr;
+	program->cached = false;
+	program->released = false;
+	program->references = 1;
+	program->begin = std::chrono::high_resolution_clock::now();
+	this->m_programs[key] = program;
+
+	if (this->m_compiler != nullptr)
+	{
+		program->state = PROGRAM_QUEUED;
+		this->m_compileQueue.push_back(program);
+		this->m_compiler->wake();
+	}
+	else
+	{
+		program->state = PROGRAM_BUILDING;
+		this->buildProgram(program);
+		// without parallel compilation and without a compiler there is nothing to wait for later
+		if (!this->m_parallelCompile)
+		{
+			this->finishProgram(program, true);
+			program->state = program->id != 0 ? PROGRAM_READY : PROGRAM_FAILED;
+		}
+	}
+	return program;
+}
+
+void FContextGroup::buildProgram(Program *program)
+{
+	if (this->m_programCache != nullptr)
+	{
+		program->id = this->m_programCache->load(program->vertexShaderSource.c_str(), program->fragmentShaderSource.c_str());
+		program->cached = program->id != 0;
+	}
+
+	if (!program->cached)
+	{
+		// the limit is a state of the context, so it is set by every context issuing programs
+		if (this->m_maxShaderCompilerThreads != nullptr)
+			this->m_maxShaderCompilerThreads(0xFFFFFFFF);
+
+		const char *vertexShaderSource = program->vertexShaderSource.c_str();
+		const char *fragmentShaderSource = program->fragmentShaderSource.c_str();
+
+		program->vertexShader = glCreateShader(GL_VERTEX_SHADER);
+		glShaderSource(program->vertexShader, 1, &vertexShaderSource, nullptr);
+		glCompileShader(program->vertexShader);
+
+		program->fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+		glShaderSource(program->fragmentShader, 1, &fragmentShaderSource, nullptr);
+		glCompileShader(program->fragmentShader);
+
+		// neither compiling nor linking waits for the driver as long as no status is queried
+		program->id = glCreateProgram();
+		glAttachShader(program->id, program->vertexShader);
+		glAttachShader(program->id, program->fragmentShader);
+		if (this->m_programCache != nullptr && FProgramCache::isSupported())
+			glProgramParameteri(program->id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glLinkProgram(program->id);
+	}
+
+	if (this->m_parallelCompile)
+	{
+		program->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+	}
+}
+
+bool FContextGroup::finishProgram(Program *program, const bool wait)
+{
+	if (!wait)
+	{
+		GLenum fenceStatus = glClientWaitSync(program->fence, 0, 0);
+		if (fenceStatus != GL_ALREADY_SIGNALED && fenceStatus != GL_CONDITION_SATISFIED)
+			return false;
+
+		GLint completed = GL_FALSE;
+		glGetProgramiv(program->id, COMPLETION_STATUS, &completed);
+		if (completed != GL_TRUE)
+			return false;
+	}
+
+	if (program->fence != nullptr)
+	{
+		glDeleteSync(program->fence);
+		program->fence = nullptr;
+	}
+
+	GLint linked = GL_FALSE;
+	glGetProgramiv(program->id, GL_LINK_STATUS, &linked);
+	if (linked != GL_TRUE)
+	{
+		char log[512] = "";
+		glGetProgramInfoLog(program->id, sizeof(log), nullptr, log);
+		FLogger::error("FContextGroup", "could not link the program: {}", log);
+		for (uint32_t shader : {program->vertexShader, program->fragmentShader})
+		{
+			GLint compiled = GL_TRUE;
+			if (shader != 0)
+				glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+			if (compiled == GL_TRUE)
+				continue;
+
+			glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+			FLogger::error("FContextGroup", "could not compile the {} shader: {}", shader == program->vertexShader ? "vertex" : "fragment", log);
+		}
+	}
+
+	if (program->vertexShader != 0)
+	{
+		// the program keeps its binary, the shaders are not needed by any other program
+		glDetachShader(program->id, program->vertexShader);
+		glDetachShader(program->id, program->fragmentShader);
+		glDeleteShader(program->vertexShader);
+		glDeleteShader(program->fragmentShader);
+		program->vertexShader = 0;
+		program->fragmentShader = 0;
+	}
+
+	if (linked != GL_TRUE)
+	{
+		glDeleteProgram(program->id);
+		program->id = 0;
+		return true;
+	}
+
+	if (!program->cached && this->m_programCache != nullptr)
+		this->m_programCache->store(program->id, program->vertexShaderSource.c_str(), program->fragmentShaderSource.c_str());
+
+	// other contexts of the group may only use the program once its creation has completed
+	if (wait)
+		glFinish();
+
+	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - program->begin);
+	FLogger::info("FContextGroup", "{} program {} in {} us", program->cached ? "loaded" : "compiled", program->id, duration.count());
+	return true;
+}
+
+void FContextGroup::deleteProgram(Program *program)
+{
+	if (program->fence != nullptr)
+		glDeleteSync(program->fence);
+	if (program->vertexShader != 0)
+	{
+		glDeleteShader(program->vertexShader);
+		glDeleteShader(program->fragmentShader);
+	}
+	if (program->id != 0)
+		glDeleteProgram(program->id);
+	delete program;
+}
+
+uint32_t FContextGroup::getProgram(Program *program)
+{
+	ProgramState state = program->state;
+	if (state == PROGRAM_READY)
+		return program->id;
+	// programs of the compiler are finished by the compiler
+	if (state != PROGRAM_BUILDING || !this->m_parallelCompile)
+		return 0;
+
+	std::lock_guard<FMutex> lock(this->m_mutex);
+	if (program->state == PROGRAM_BUILDING && this->finishProgram(program, false))
+		program->state = program->id != 0 ? PROGRAM_READY : PROGRAM_FAILED;
+	return program->state == PROGRAM_READY ? program->id : 0;
+}
+
+bool FContextGroup::hasProgramFailed(const Program *program) const
+{
+	return program->state == PROGRAM_FAILED;
+}
+
+void FContextGroup::releaseProgram(Program *program)
+{
+	std::lock_guard<FMutex> lock(this->m_mutex);
+
+	if (--program->references > 0)
+		return;
+
+	this->m_programs.erase(std::make_pair(program->vertexShaderSource, program->fragmentShaderSource));
+	if (program->state == PROGRAM_QUEUED)
+	{
+		this->m_compileQueue.erase(std::remove(this->m_compileQueue.begin(), this->m_compileQueue.end(), program), this->m_compileQueue.end());
+		delete program;
+	}
+	else if (program->state == PROGRAM_BUILDING && !this->m_parallelCompile)
+	{
+		// the compiler deletes the program once it is done with it
+		program->released = true;
+	}
+	else
+	{
+		deleteProgram(program);
+	}
+}
+
+FContextGroup::Program *FContextGroup::takeCompile()
+{
+	std::lock_guard<FMutex> lock(this->m_mutex);
+	if (this->m_compileQueue.empty())
+		return nullptr;
+
+	Program *program = this->m_compileQueue.front();
+	this->m_compileQueue.erase(this->m_compileQueue.begin());
+	program->state = PROGRAM_BUILDING;
+	return program;
+}
+
+void FContextGroup::compile(Program *program)
+{
+	this->buildProgram(program);
+	this->finishProgram(program, true);
+
+	this->m_mutex.lock();
+	bool released = program->released;
+	if (!released)
+		program->state = program->id != 0 ? PROGRAM_READY : PROGRAM_FAILED;
+	this->m_mutex.unlock();
+
+	if (released)
+		deleteProgram(program);
+}
+
+uint32_t FContextGroup::acquireBuffer(const std::vector<float> &vertices)
+{
+	std::lock_guard<FMutex> lock(this->m_mutex);
+
+	auto iterator = this->m_buffers.find(vertices);
+	if (iterator != this->m_buffers.end())
+	{
+		iterator->second.references++;
+		return iterator->second.id;
+	}
+
+	uint32_t buffer;
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(float) * vertices.size()), vertices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// other contexts of the group may only use the buffer once the upload has completed
+	glFinish();
+
+	this->m_buffers[vertices] = {buffer, 1};
+	return buffer;
+}
+
+void FContextGroup::releaseBuffer(const uint32_t buffer)
+{
+	std::lock_guard<FMutex> lock(this->m_mutex);
+
+	for (auto iterator = this->m_buffers.begin(); iterator != this->m_buffers.end(); ++iterator)
+	{
+		if (iterator->second.id != buffer)
+			continue;
+
+		if (--iterator->second.references == 0)
+		{
+			glDeleteBuffers(1, &buffer);
+			this->m_buffers.erase(iterator);
+		}
+		return;
+	}
+}
+
+
+//---------------------------------------------------------------------------//
+//                                Compiler Class                             //
+//---------------------------------------------------------------------------//
+
+FContextGroup::Compiler::Compiler(FContextGroup *group, GLFWwindow *window) : FThread("FContextGroup-Compiler", -1.0, QUEUE_DISABLED)
+{
+	this->m_group = group;
+	this->m_window = window;
+}
+
+void FContextGroup::Compiler::onStart()
+{
+	glfwMakeContextCurrent(this->m_window);
+}
+
+void FContextGroup::Compiler::onTick(const unsigned long, const unsigned long)
+{
+	Program *program = this->m_group->takeCompile();
+	if (program != nullptr)
+		this->m_group->compile(program);
+	else
+		this->m_clock->sleepUntil(&this->m_sleeper, FClock::FOREVER);
+}
+
+void FContextGroup::Compiler::onStop()
+{
+	glfwMakeContextCurrent(nullptr);
+}
@@ -0,0 +1,282 @@
+/*
+ * FContextGroup.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FCONTEXTGROUP_HPP_
+#define CORE_CONCURRENT_FCONTEXTGROUP_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <thread>
+#include <cstdint>
+
+#include "FThread.hpp"
+#include "FMutex.hpp"
+#include "FProgramCache.hpp"
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+
+/**
+ * Class sharing the GL objects of a group of windows.
+ *
+ * <p>Every window of a group creates its context sharing the objects of the other contexts of the group. The first window
+ * that needs a program or a vertex buffer creates it, later windows get the same object, so programs are compiled and
+ * vertices are uploaded once per group instead of once per window. Objects are reference counted and deleted when the
+ * last window releases them. Vertex array objects cannot be shared and stay owned by each window.</p>
+ *
+ * <p>Programs are built asynchronously. {@link #acquireProgram()} only issues the compilation and returns at once, so a
+ * render FThread issues the programs of all its windows up front and polls them with {@link #getProgram()} on later
+ * ticks. If the driver supports <code>GL_KHR_parallel_shader_compile</code> the driver compiles in the background of the
+ * acquiring context, otherwise a compiler FThread with a hidden window of the group compiles one program after another.
+ * </p>
+ *
+ * <p>The windows of a group may be rendered by different FThreads. An object is only handed out once the commands
+ * creating it have been executed, so it is complete when another context binds it.</p>
+ */
+class FContextGroup
+{
+public:
+
+	/**
+	 * A program shared by the windows of the group, defined in the source file.
+	 */
+	struct Program;
+
+private:
+
+	/**
+	 * FThread compiling the programs of a group whose driver cannot compile in parallel.
+	 */
+	class Compiler : public FThread
+	{
+	private:
+
+		/**
+		 * A pointer to the group of the compiler.
+		 */
+		FContextGroup *m_group;
+		/**
+		 * The hidden GLFW window whose context the compiler uses.
+		 */
+		GLFWwindow *m_window;
+
+	protected:
+
+		void onStart() override;
+
+		void onTick(unsigned long currentTime, unsigned long currentTick) override;
+
+		void onStop() override;
+
+	public:
+
+		Compiler(FContextGroup *group, GLFWwindow *window);
+	};
+
+	/**
+	 * A shared vertex buffer with the number of windows using it.
+	 */
+	struct Buffer
+	{
+		uint32_t id;
+		unsigned int references;
+	};
+
+	/**
+	 * The cache programs are loaded from and stored in, <code>nullptr</code> to always compile them.
+	 */
+	FProgramCache *m_programCache;
+	/**
+	 * Mutex for the members of the group.
+	 */
+	FMutex m_mutex;
+	/**
+	 * The GLFW windows of the group whose contexts exist.
+	 */
+	std::vector<GLFWwindow *> m_windows;
+	/**
+	 * Whether the driver compiles programs in the background of the context issuing them.
+	 */
+	bool m_parallelCompile;
+	/**
+	 * The function limiting the number of threads the driver compiles with, <code>nullptr</code> without parallel
+	 * compilation.
+	 */
+	void (*m_maxShaderCompilerThreads)(GLuint count);
+	/**
+	 * The compiler FThread, <code>nullptr</code> while the driver compiles in parallel or the group has no windows.
+	 */
+	Compiler *m_compiler;
+	/**
+	 * The std::thread of the compiler.
+	 */
+	std::thread *m_compilerThread;
+	/**
+	 * The hidden GLFW window of the compiler.
+	 */
+	GLFWwindow *m_compilerWindow;
+	/**
+	 * The programs waiting for the compiler.
+	 */
+	std::vector<Program *> m_compileQueue;
+	/**
+	 * The programs of the group by the sources of their vertex and fragment shaders.
+	 */
+	std::map<std::pair<std::string, std::string>, Program *> m_programs;
+	/**
+	 * The vertex buffers of the group by their vertices.
+	 */
+	std::map<std::vector<float>, Buffer> m_buffers;
+
+	/**
+	 * Creates a program in the current context, loading it from the program cache if possible.
+	 *
+	 * <p>Only waits for the driver if it cannot compile in parallel.</p>
+	 *
+	 * @param program A pointer to the program.
+	 */
+	void buildProgram(Program *program);
+
+	/**
+	 * Finishes a built program in the current context once the driver completed it.
+	 *
+	 * @param program A pointer to the program.
+	 * @param wait Whether to wait for the driver.
+	 * @return <code>false</code> if the driver is still building the program.
+	 */
+	bool finishProgram(Program *program, bool wait);
+
+	/**
+	 * Deletes a program and its GL objects in the current context.
+	 *
+	 * @param program A pointer to the program.
+	 */
+	static void deleteProgram(Program *program);
+
+	/**
+	 * Takes the next program from the compile queue.
+	 *
+	 * @return a pointer to the program or <code>nullptr</code> if the queue is empty.
+	 */
+	Program *takeCompile();
+
+	/**
+	 * Builds and finishes a program taken from the compile queue on the compiler FThread.
+	 *
+	 * @param program A pointer to the program.
+	 */
+	void compile(Program *program);
+
+	/**
+	 * Starts the compiler FThread if the driver of the given window cannot compile in parallel, must be called on the
+	 * main thread. The first call of the process loads the GL functions with the context of the given window.
+	 *
+	 * @param window A pointer to the first GLFW window of the group.
+	 */
+	void startCompiler(GLFWwindow *window);
+
+	/**
+	 * Stops the compiler FThread and destroys its window, must be called on the main thread.
+	 */
+	void stopCompiler();
+
+public:
+
+	/**
+	 * Constructs a new FContextGroup without windows.
+	 *
+	 * @param programCache A pointer to the cache programs are loaded from and stored in, must outlive the group.
+	 * 		Programs are always compiled if it is <code>nullptr</code>.
+	 */
+	explicit FContextGroup(FProgramCache *programCache = nullptr);
+
+	/**
+	 * Destroys the FContextGroup. The windows of the group must have released their objects already.
+	 */
+	~FContextGroup();
+
+	/**
+	 * Gets the GLFW window whose context a new window of the group has to share.
+	 *
+	 * @return a pointer to a GLFW window of the group or <code>nullptr</code> for the first window.
+	 */
+	[[nodiscard]] GLFWwindow *getShareWindow();
+
+	/**
+	 * Adds a created GLFW window to the group, must be called on the main thread.
+	 *
+	 * <p>The context of the first window decides how programs are compiled, it must not be current on any thread. The
+	 * first window of the process also loads the GL functions, so a window must be added before its context is used.</p>
+	 *
+	 * @param window A pointer to the GLFW window, its context must share the context of {@link #getShareWindow()}.
+	 */
+	void addWindow(GLFWwindow *window);
+
+	/**
+	 * Removes a GLFW window from the group before it is destroyed, must be called on the main thread.
+	 *
+	 * @param window A pointer to the GLFW window.
+	 */
+	void removeWindow(GLFWwindow *window);
+
+	/**
+	 * Gets the program linked from the given shaders, issuing its creation if the group does not have it.
+	 *
+	 * <p>A new program is loaded from the program cache if possible, otherwise it is compiled and stored in the cache. The
+	 * program is built in the current context or by the compiler FThread, this method never waits for it.</p>
+	 *
+	 * @param vertexShaderSource The source of the vertex shader.
+	 * @param fragmentShaderSource The source of the fragment shader.
+	 * @return a pointer to the program, use {@link #getProgram()} to get its name once it is ready.
+	 */
+	Program *acquireProgram(const char *vertexShaderSource, const char *fragmentShaderSource);
+
+	/**
+	 * Gets the name of a program if it is ready, checking whether the driver has completed it otherwise.
+	 *
+	 * @param program A pointer to the program.
+	 * @return the name of the program, 0 while it is being built or if it could not be linked.
+	 */
+	uint32_t getProgram(Program *program);
+
+	/**
+	 * Gets whether a program could not be linked.
+	 *
+	 * @param program A pointer to the program.
+	 * @return <code>true</code> if the program will never become ready.
+	 */
+	[[nodiscard]] bool hasProgramFailed(const Program *program) const;
+
+	/**
+	 * Releases a program acquired by {@link #acquireProgram()}, deleting it in the current context if it is not used
+	 * anymore.
+	 *
+	 * @param program A pointer to the program.
+	 */
+	void releaseProgram(Program *program);
+
+	/**
+	 * Gets a vertex buffer holding the given vertices, uploading them in the current context if the group does not have
+	 * such a buffer.
+	 *
+	 * @param vertices A reference to the vertices.
+	 * @return the name of the buffer.
+	 */
+	uint32_t acquireBuffer(const std::vector<float> &vertices);
+
+	/**
+	 * Releases a vertex buffer acquired by {@link #acquireBuffer()}, deleting it in the current context if it is not used
+	 * anymore.
+	 *
+	 * @param buffer The name of the buffer.
+	 */
+	void releaseBuffer(uint32_t buffer);
+};
+
+
+#endif /* CORE_CONCURRENT_FCONTEXTGROUP_HPP_ */
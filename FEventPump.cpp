@@ -0,0 +1,221 @@
+/*
+ * FEventPump.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FEventPump.hpp"
+#include <algorithm>
+
+
+//---------------------------------------------------------------------------//
+//                              Event Pump Class                             //
+//---------------------------------------------------------------------------//
+
+FEventPump::FEventPump(const double timeout)
+{
+	this->m_mainThread = std::this_thread::get_id();
+	this->m_timeout = timeout;
+	this->m_taskMutex.setName("FEventPump::m_taskMutex");
+	this->m_tasks = std::vector<std::function<void()>>();
+	this->m_windows = std::vector<FWindow *>();
+}
+
+void FEventPump::attach(FWindow *window, FThread *owner)
+{
+	window->m_eventOwner = owner;
+	window->m_pendingEvents.clear();
+	window->m_eventBatchQueued = false;
+	window->m_eventsHeldBack = false;
+	this->m_windows.push_back(window);
+
+	GLFWwindow *glfwWindow = window->getHandle();
+	glfwSetWindowCloseCallback(glfwWindow, [] (GLFWwindow *glfwWindow) {
+		FWindowEvent event{};
+		event.type = WINDOW_EVENT_CLOSE;
+		record(glfwWindow, event);
+	});
+	glfwSetFramebufferSizeCallback(glfwWindow, [] (GLFWwindow *glfwWindow, int width, int height) {
+		FWindowEvent event{};
+		event.type = WINDOW_EVENT_FRAMEBUFFER_SIZE;
+		event.width = width;
+		event.height = height;
+		record(glfwWindow, event);
+	});
+	glfwSetWindowFocusCallback(glfwWindow, [] (GLFWwindow *glfwWindow, int focused) {
+		FWindowEvent event{};
+		event.type = WINDOW_EVENT_FOCUS;
+		event.action = focused;
+		record(glfwWindow, event);
+	});
+	glfwSetWindowRefreshCallback(glfwWindow, [] (GLFWwindow *glfwWindow) {
+		FWindowEvent event{};
+		event.type = WINDOW_EVENT_REFRESH;
+		record(glfwWindow, event);
+	});
+	glfwSetKeyCallback(glfwWindow, [] (GLFWwindow *glfwWindow, int key, int scancode, int action, int mods) {
+		FWindowEvent event{};
+		event.type = WINDOW_EVENT_KEY;
+		event.code = key;
+		event.scancode = scancode;
+		event.action = action;
+		event.mods = mods;
+		record(glfwWindow, event);
+	});
+	glfwSetCharCallback(glfwWindow, [] (GLFWwindow *glfwWindow, unsigned int codepoint) {
+		FWindowEvent event{};
+		event.type = WINDOW_EVENT_CHARACTER;
+		event.code = static_cast<int>(codepoint);
+		record(glfwWindow, event);
+	});
+	glfwSetMouseButtonCallback(glfwWindow, [] (GLFWwindow *glfwWindow, int button, int action, int mods) {
+		FWindowEvent event{};
+		event.type = WINDOW_EVENT_MOUSE_BUTTON;
+		event.code = button;
+		event.action = action;
+		event.mods = mods;
+		record(glfwWindow, event);
+	});
+	glfwSetCursorPosCallback(glfwWindow, [] (GLFWwindow *glfwWindow, double x, double y) {
+		FWindowEvent event{};
+		event.type = WINDOW_EVENT_CURSOR_MOVE;
+		event.x = x;
+		event.y = y;
+		record(glfwWindow, event);
+	});
+	glfwSetScrollCallback(glfwWindow, [] (GLFWwindow *glfwWindow, double x, double y) {
+		FWindowEvent event{};
+		event.type = WINDOW_EVENT_SCROLL;
+		event.x = x;
+		event.y = y;
+		record(glfwWindow, event);
+	});
+}
+
+void FEventPump::detach(FWindow *window)
+{
+	GLFWwindow *glfwWindow = window->getHandle();
+	if (glfwWindow != nullptr)
+	{
+		glfwSetWindowCloseCallback(glfwWindow, nullptr);
+		glfwSetFramebufferSizeCallback(glfwWindow, nullptr);
+		glfwSetWindowFocusCallback(glfwWindow, nullptr);
+		glfwSetWindowRefreshCallback(glfwWindow, nullptr);
+		glfwSetKeyCallback(glfwWindow, nullptr);
+		glfwSetCharCallback(glfwWindow, nullptr);
+		glfwSetMouseButtonCallback(glfwWindow, nullptr);
+		glfwSetCursorPosCallback(glfwWindow, nullptr);
+		glfwSetScrollCallback(glfwWindow, nullptr);
+	}
+
+	this->m_windows.erase(std::remove(this->m_windows.begin(), this->m_windows.end(), window), this->m_windows.end());
+	window->m_eventOwner = nullptr;
+	window->m_pendingEvents.clear();
+}
+
+void FEventPump::record(GLFWwindow *glfwWindow, FWindowEvent event)
+{
+	auto *window = reinterpret_cast<FWindow *>(glfwGetWindowUserPointer(glfwWindow));
+	if (window == nullptr || window->m_eventOwner == nullptr)
+		return;
+
+	event.time = window->m_eventOwner->getClock()->now().count();
+
+	// only the latest position of a cursor movement matters to the owner
+	std::vector<FWindowEvent> &events = window->m_pendingEvents;
+	if (event.type == WINDOW_EVENT_CURSOR_MOVE && !events.empty() && events.back().type == WINDOW_EVENT_CURSOR_MOVE)
+		events.back() = event;
+	else
+		events.push_back(event);
+}
+
+void FEventPump::flush()
+{
+	for (FWindow *window : this->m_windows)
+	{
+		if (window->m_pendingEvents.empty())
+			continue;
+
+		FThread *owner = window->m_eventOwner;
+		if (!owner->isRunning())
+		{
+			// a starting owner gets the events once it accepts tasks, a stopped one drops them
+			if (!owner->hasStarted() || owner->isStopping())
+				window->m_pendingEvents.clear();
+			continue;
+		}
+
+		if (window->m_eventBatchQueued)
+		{
+			window->m_eventsHeldBack = true;
+			// the owner wakes the pump up when it handles the queued batch, unless it did so right before
+			if (window->m_eventBatchQueued)
+				continue;
+			window->m_eventsHeldBack = false;
+		}
+
+		window->m_eventBatchQueued = true;
+		owner->addTask([window, events = std::move(window->m_pendingEvents)] {
+			window->m_eventBatchQueued = false;
+			window->handleEvents(events);
+			if (window->m_eventsHeldBack.exchange(false))
+				FEventPump::wake();
+		});
+		window->m_pendingEvents = std::vector<FWindowEvent>();
+	}
+}
+
+void FEventPump::runTasks()
+{
+	std::vector<std::function<void()>> tasks;
+	this->m_taskMutex.lock();
+	tasks.swap(this->m_tasks);
+	this->m_taskMutex.unlock();
+
+	for (std::function<void()> &task : tasks)
+		task();
+}
+
+void FEventPump::execute(const std::function<void()> &task)
+{
+	if (this->isMainThread())
+	{
+		task();
+		return;
+	}
+
+	this->m_taskMutex.lock();
+	this->m_tasks.push_back(task);
+	this->m_taskMutex.unlock();
+	wake();
+}
+
+void FEventPump::pump(const double timeout)
+{
+	if (timeout > 0.0)
+		glfwWaitEventsTimeout(timeout);
+	else
+		glfwPollEvents();
+
+	this->runTasks();
+	this->flush();
+}
+
+void FEventPump::run(const std::function<bool()> &condition)
+{
+	while (condition())
+		this->pump(this->m_timeout);
+
+	this->runTasks();
+}
+
+void FEventPump::wake()
+{
+	glfwPostEmptyEvent();
+}
+
+bool FEventPump::isMainThread() const
+{
+	return std::this_thread::get_id() == this->m_mainThread;
+}
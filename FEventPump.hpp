@@ -0,0 +1,178 @@
+/*
+ * FEventPump.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FEVENTPUMP_HPP_
+#define CORE_CONCURRENT_FEVENTPUMP_HPP_
+
+#include <vector>
+#include <functional>
+#include <thread>
+
+#include "FThread.hpp"
+#include "FWindow.hpp"
+
+/**
+ * Class running the GLFW event loop on the main thread.
+ *
+ * <p>GLFW only allows polling events and creating or destroying windows on the main thread. The pump records the events of
+ * every attached window into a timestamped buffer and hands the buffer to the FThread owning the window as a single task.
+ * A window never has more than one batch waiting in the task queue of its owner, so the owner receives at most one batch
+ * per tick and the events in between are kept in the buffer. Consecutive cursor moves are coalesced into one event.</p>
+ *
+ * <p>Other threads run GLFW calls on the main thread through {@link #execute()} or an {@link FMainThreadExecutor}.</p>
+ */
+class FEventPump
+{
+private:
+
+	/**
+	 * The thread that constructed the pump.
+	 */
+	std::thread::id m_mainThread;
+	/**
+	 * The time in seconds the pump waits for events before it checks for held back events again.
+	 */
+	double m_timeout;
+	/**
+	 * Mutex for {@link #m_tasks}.
+	 */
+	FMutex m_taskMutex;
+	/**
+	 * The functions waiting to be executed on the main thread.
+	 */
+	std::vector<std::function<void()>> m_tasks;
+	/**
+	 * A list with pointers to the attached windows. Only used on the main thread.
+	 */
+	std::vector<FWindow *> m_windows;
+
+	/**
+	 * Executes the functions waiting for the main thread.
+	 */
+	void runTasks();
+
+	/**
+	 * Hands the recorded events of every window to its owner.
+	 */
+	void flush();
+
+	/**
+	 * Records an event of a window.
+	 *
+	 * @param glfwWindow A pointer to the GLFW window of the event.
+	 * @param event The event, its time is set by this method.
+	 */
+	static void record(GLFWwindow *glfwWindow, FWindowEvent event);
+
+public:
+
+	/**
+	 * Constructs a new FEventPump, must be called on the main thread.
+	 *
+	 * @param timeout The longest time in seconds events are held back while a batch of their window is queued.
+	 */
+	explicit FEventPump(double timeout = 0.005);
+
+	/**
+	 * Records the events of a window and delivers them to the given FThread, must be called on the main thread.
+	 *
+	 * @param window A pointer to the created window.
+	 * @param owner A pointer to the FThread the events are delivered to.
+	 */
+	void attach(FWindow *window, FThread *owner);
+
+	/**
+	 * Stops recording the events of a window, must be called on the main thread.
+	 *
+	 * <p>Batches that have been queued already are still delivered, so the window must stay alive until the owner has
+	 * executed its pending tasks.</p>
+	 *
+	 * @param window A pointer to the window.
+	 */
+	void detach(FWindow *window);
+
+	/**
+	 * Executes a function on the main thread.
+	 *
+	 * <p>The function is executed immediately when called on the main thread, otherwise during the next iteration of the
+	 * pump.</p>
+	 *
+	 * @param task The function that will be executed.
+	 */
+	void execute(const std::function<void()> &task);
+
+	/**
+	 * Waits for events, executes the pending functions and delivers the recorded events once.
+	 *
+	 * @param timeout The longest time in seconds to wait for events, zero to only poll.
+	 */
+	void pump(double timeout);
+
+	/**
+	 * Pumps events on the calling main thread as long as the given condition holds.
+	 *
+	 * <p>The functions still waiting afterwards are executed before returning.</p>
+	 *
+	 * @param condition The condition, e.g. whether the render FThreads are still alive.
+	 */
+	void run(const std::function<bool()> &condition);
+
+	/**
+	 * Wakes the pump up if it is waiting for events.
+	 */
+	static void wake();
+
+	/**
+	 * Gets whether the calling thread is the main thread.
+	 *
+	 * @return <code>true</code> on the main thread.
+	 */
+	[[nodiscard]] bool isMainThread() const;
+};
+
+/**
+ * Executor running functions on the main thread through an {@link FEventPump}.
+ */
+class FMainThreadExecutor
+{
+private:
+
+	/**
+	 * A pointer to the event pump of the main thread.
+	 */
+	FEventPump *m_pump;
+
+public:
+
+	/**
+	 * Constructs a new FMainThreadExecutor.
+	 *
+	 * @param pump A pointer to the event pump of the main thread.
+	 */
+	explicit FMainThreadExecutor(FEventPump *pump) : m_pump(pump)
+	{
+	}
+
+	template<typename Function>
+	void execute(Function &&function) const
+	{
+		this->m_pump->execute(std::forward<Function>(function));
+	}
+
+	bool operator==(const FMainThreadExecutor &other) const
+	{
+		return this->m_pump == other.m_pump;
+	}
+
+	bool operator!=(const FMainThreadExecutor &other) const
+	{
+		return this->m_pump != other.m_pump;
+	}
+};
+
+
+#endif /* CORE_CONCURRENT_FEVENTPUMP_HPP_ */
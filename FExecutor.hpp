@@ -0,0 +1,717 @@
+/*
+ * FExecutor.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FEXECUTOR_HPP_
+#define CORE_CONCURRENT_FEXECUTOR_HPP_
+
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <atomic>
+
+#include "FThread.hpp"
+
+/*
+ * Executors and a small sender/receiver layer modeled after P2300.
+ *
+ * An executor is any type with an execute(function) method that runs the given function at some point, e.g. on an
+ * FThread or a thread pool. An executor that may reject functions returns a bool from execute(), a sender whose function
+ * was rejected completes with an FExecutionRejected error instead of never completing. Senders describe work without
+ * running it: schedule(executor) completes on the executor, then(sender, function) transforms the value of a sender,
+ * continueOn(sender, executor) moves the completion to another executor and whenAll(senders...) completes once every
+ * sender has completed. syncWait() and startDetached() run a sender.
+ *
+ * Connecting a sender to a receiver yields an operation state which must stay in place once start() was called.
+ * Every hop between threads posts a function capturing a single pointer to its operation state, which fits the small
+ * buffer of std::function, so composing work does not allocate intermediate functions.
+ */
+
+/**
+ * Type trait checking whether a type is an executor.
+ *
+ * @tparam Executor The type that is checked.
+ */
+template<typename Executor, typename = void>
+struct FIsExecutor : std::false_type
+{
+};
+
+template<typename Executor>
+struct FIsExecutor<Executor, std::void_t<decltype(std::declval<const Executor &>().execute(std::declval<void (*)()>()))>>
+		: std::true_type
+{
+};
+
+/**
+ * Error a sender completes with if its executor rejected the function completing it.
+ */
+class FExecutionRejected : public std::runtime_error
+{
+public:
+
+	explicit FExecutionRejected(const std::string &message) : std::runtime_error(message)
+	{
+	}
+};
+
+/**
+ * Executor running functions in the task queue of an FThread.
+ *
+ * <p>Functions are rejected like every other task if the FThread is not running.</p>
+ */
+class FThreadExecutor
+{
+private:
+
+	/**
+	 * A pointer to the FThread the functions are executed on.
+	 */
+	FThread *m_thread;
+
+public:
+
+	/**
+	 * Constructs a new FThreadExecutor.
+	 *
+	 * @param thread A pointer to the FThread the functions are executed on.
+	 */
+	explicit FThreadExecutor(FThread *thread) : m_thread(thread)
+	{
+	}
+
+	/**
+	 * Adds the given function to the task queue of the FThread.
+	 *
+	 * @param function The function that will be executed.
+	 * @return <code>false</code> if the function was dropped because the FThread is not running.
+	 */
+	template<typename Function>
+	bool execute(Function &&function) const
+	{
+		return this->m_thread->addTask(std::forward<Function>(function));
+	}
+
+	bool operator==(const FThreadExecutor &other) const
+	{
+		return this->m_thread == other.m_thread;
+	}
+
+	bool operator!=(const FThreadExecutor &other) const
+	{
+		return this->m_thread != other.m_thread;
+	}
+};
+
+/**
+ * Executor running functions immediately on the calling thread.
+ */
+class FInlineExecutor
+{
+public:
+
+	template<typename Function>
+	void execute(Function &&function) const
+	{
+		function();
+	}
+};
+
+/**
+ * Placeholder for the value of a sender without a value, e.g. in the tuple of {@link #whenAll()}.
+ */
+struct FNone
+{
+};
+
+/**
+ * Maps <code>void</code> to {@link FNone} so it can be stored.
+ */
+template<typename Value>
+using FStoredValue = std::conditional_t<std::is_void_v<Value>, FNone, Value>;
+
+/**
+ * Converts to the result of its function, so an operation state can be constructed in place by std::optional::emplace().
+ */
+template<typename Function>
+struct FInPlace
+{
+	Function function;
+
+	operator std::invoke_result_t<Function>()
+	{
+		return this->function();
+	}
+};
+
+template<typename Function>
+FInPlace(Function) -> FInPlace<Function>;
+
+/**
+ * Runs a function on an executor and completes the given receiver with an {@link FExecutionRejected} error if the
+ * executor rejected it.
+ */
+template<typename Executor, typename Function, typename Receiver>
+void FExecuteOrReject(const Executor &executor, Function &&function, Receiver &receiver)
+{
+	if constexpr (std::is_same_v<decltype(executor.execute(std::forward<Function>(function))), bool>)
+	{
+		if (!executor.execute(std::forward<Function>(function)))
+			receiver.setError(std::make_exception_ptr(FExecutionRejected("the executor is not running")));
+	}
+	else
+	{
+		executor.execute(std::forward<Function>(function));
+	}
+}
+
+/**
+ * The type of the operation state a sender returns when connected to a receiver.
+ */
+template<typename Sender, typename Receiver>
+using FOperationType = decltype(std::declval<Sender &>().connect(std::declval<Receiver>()));
+
+
+//---------------------------------------------------------------------------//
+//                                  schedule                                 //
+//---------------------------------------------------------------------------//
+
+template<typename Executor, typename Receiver>
+class FScheduleOperation
+{
+private:
+
+	Executor m_executor;
+	Receiver m_receiver;
+
+public:
+
+	FScheduleOperation(Executor executor, Receiver receiver) : m_executor(std::move(executor)), m_receiver(std::move(receiver))
+	{
+	}
+
+	void start()
+	{
+		FExecuteOrReject(this->m_executor, [this] { this->m_receiver.setValue(); }, this->m_receiver);
+	}
+};
+
+/**
+ * Sender completing without a value on an executor.
+ */
+template<typename Executor>
+class FScheduleSender
+{
+private:
+
+	Executor m_executor;
+
+public:
+
+	using ValueType = void;
+
+	explicit FScheduleSender(Executor executor) : m_executor(std::move(executor))
+	{
+	}
+
+	template<typename Receiver>
+	FScheduleOperation<Executor, Receiver> connect(Receiver receiver)
+	{
+		return FScheduleOperation<Executor, Receiver>(this->m_executor, std::move(receiver));
+	}
+};
+
+/**
+ * Creates a sender that completes on the given executor.
+ *
+ * @param executor The executor the sender completes on.
+ *
+ * @return the sender.
+ */
+template<typename Executor>
+FScheduleSender<Executor> schedule(Executor executor)
+{
+	static_assert(FIsExecutor<Executor>::value, "schedule() requires an executor");
+	return FScheduleSender<Executor>(std::move(executor));
+}
+
+
+//---------------------------------------------------------------------------//
+//                                    then                                   //
+//---------------------------------------------------------------------------//
+
+template<typename Value, typename Function>
+struct FThenResult
+{
+	using type = std::invoke_result_t<Function, Value>;
+};
+
+template<typename Function>
+struct FThenResult<void, Function>
+{
+	using type = std::invoke_result_t<Function>;
+};
+
+template<typename Sender, typename Function, typename Receiver>
+class FThenOperation
+{
+private:
+
+	struct ThenReceiver
+	{
+		FThenOperation *operation;
+
+		template<typename... Values>
+		void setValue(Values &&... values)
+		{
+			using Result = std::invoke_result_t<Function, Values...>;
+			Receiver &receiver = this->operation->m_receiver;
+
+			// only the function may fail, a receiver that already accepted the value must not get an error as well
+			if constexpr (std::is_void_v<Result>)
+			{
+				try
+				{
+					this->operation->m_function(std::forward<Values>(values)...);
+				}
+				catch (...)
+				{
+					receiver.setError(std::current_exception());
+					return;
+				}
+				receiver.setValue();
+			}
+			else
+			{
+				std::optional<Result> result;
+				try
+				{
+					result.emplace(this->operation->m_function(std::forward<Values>(values)...));
+				}
+				catch (...)
+				{
+					receiver.setError(std::current_exception());
+					return;
+				}
+				receiver.setValue(std::move(*result));
+			}
+		}
+
+		void setError(std::exception_ptr error)
+		{
+			this->operation->m_receiver.setError(error);
+		}
+	};
+
+	Sender m_sender;
+	Function m_function;
+	Receiver m_receiver;
+	std::optional<FOperationType<Sender, ThenReceiver>> m_operation;
+
+public:
+
+	FThenOperation(Sender sender, Function function, Receiver receiver)
+			: m_sender(std::move(sender)), m_function(std::move(function)), m_receiver(std::move(receiver))
+	{
+	}
+
+	void start()
+	{
+		this->m_operation.emplace(FInPlace{[this] { return this->m_sender.connect(ThenReceiver{this}); }});
+		this->m_operation->start();
+	}
+};
+
+/**
+ * Sender passing the value of another sender through a function.
+ */
+template<typename Sender, typename Function>
+class FThenSender
+{
+private:
+
+	Sender m_sender;
+	Function m_function;
+
+public:
+
+	using ValueType = typename FThenResult<typename Sender::ValueType, Function>::type;
+
+	FThenSender(Sender sender, Function function) : m_sender(std::move(sender)), m_function(std::move(function))
+	{
+	}
+
+	template<typename Receiver>
+	FThenOperation<Sender, Function, Receiver> connect(Receiver receiver)
+	{
+		return FThenOperation<Sender, Function, Receiver>(this->m_sender, this->m_function, std::move(receiver));
+	}
+};
+
+/**
+ * Creates a sender that passes the value of the given sender through a function.
+ *
+ * <p>The function runs wherever the given sender completes. Exceptions thrown by the function complete the sender with
+ * an error.</p>
+ *
+ * @param sender The sender whose value is passed to the function.
+ * @param function The function.
+ *
+ * @return the sender.
+ */
+template<typename Sender, typename Function>
+FThenSender<Sender, Function> then(Sender sender, Function function)
+{
+	return FThenSender<Sender, Function>(std::move(sender), std::move(function));
+}
+
+
+//---------------------------------------------------------------------------//
+//                                 continueOn                                //
+//---------------------------------------------------------------------------//
+
+template<typename Sender, typename Executor, typename Receiver>
+class FContinueOnOperation
+{
+private:
+
+	using Value = typename Sender::ValueType;
+
+	struct ContinueReceiver
+	{
+		FContinueOnOperation *operation;
+
+		template<typename... Values>
+		void setValue(Values &&... values)
+		{
+			FContinueOnOperation *operation = this->operation;
+			if constexpr (!std::is_void_v<Value>)
+				operation->m_value.emplace(std::forward<Values>(values)...);
+
+			FExecuteOrReject(operation->m_executor, [operation] {
+				if constexpr (std::is_void_v<Value>)
+					operation->m_receiver.setValue();
+				else
+					operation->m_receiver.setValue(std::move(*operation->m_value));
+			}, operation->m_receiver);
+		}
+
+		void setError(std::exception_ptr error)
+		{
+			this->operation->m_receiver.setError(error);
+		}
+	};
+
+	Sender m_sender;
+	Executor m_executor;
+	Receiver m_receiver;
+	std::optional<FStoredValue<Value>> m_value;
+	std::optional<FOperationType<Sender, ContinueReceiver>> m_operation;
+
+public:
+
+	FContinueOnOperation(Sender sender, Executor executor, Receiver receiver)
+			: m_sender(std::move(sender)), m_executor(std::move(executor)), m_receiver(std::move(receiver))
+	{
+	}
+
+	void start()
+	{
+		this->m_operation.emplace(FInPlace{[this] { return this->m_sender.connect(ContinueReceiver{this}); }});
+		this->m_operation->start();
+	}
+};
+
+/**
+ * Sender completing with the value of another sender on a different executor.
+ */
+template<typename Sender, typename Executor>
+class FContinueOnSender
+{
+private:
+
+	Sender m_sender;
+	Executor m_executor;
+
+public:
+
+	using ValueType = typename Sender::ValueType;
+
+	FContinueOnSender(Sender sender, Executor executor) : m_sender(std::move(sender)), m_executor(std::move(executor))
+	{
+	}
+
+	template<typename Receiver>
+	FContinueOnOperation<Sender, Executor, Receiver> connect(Receiver receiver)
+	{
+		return FContinueOnOperation<Sender, Executor, Receiver>(this->m_sender, this->m_executor, std::move(receiver));
+	}
+};
+
+/**
+ * Creates a sender that completes with the value of the given sender on the given executor.
+ *
+ * @param sender The sender whose value is moved to the executor.
+ * @param executor The executor the sender completes on.
+ *
+ * @return the sender.
+ */
+template<typename Sender, typename Executor>
+FContinueOnSender<Sender, Executor> continueOn(Sender sender, Executor executor)
+{
+	static_assert(FIsExecutor<Executor>::value, "continueOn() requires an executor");
+	return FContinueOnSender<Sender, Executor>(std::move(sender), std::move(executor));
+}
+
+
+//---------------------------------------------------------------------------//
+//                                  whenAll                                  //
+//---------------------------------------------------------------------------//
+
+template<typename Receiver, typename... Senders>
+class FWhenAllOperation
+{
+private:
+
+	template<size_t Index>
+	struct ChildReceiver
+	{
+		FWhenAllOperation *operation;
+
+		template<typename... Values>
+		void setValue(Values &&... values)
+		{
+			FWhenAllOperation *operation = this->operation;
+			std::get<Index>(operation->m_values).emplace(std::forward<Values>(values)...);
+			operation->complete();
+		}
+
+		void setError(std::exception_ptr error)
+		{
+			FWhenAllOperation *operation = this->operation;
+			if (!operation->m_failed.exchange(true))
+				operation->m_error = error;
+			operation->complete();
+		}
+	};
+
+	template<typename Indices>
+	struct Operations;
+
+	template<size_t... Indices>
+	struct Operations<std::index_sequence<Indices...>>
+	{
+		using type = std::tuple<std::optional<FOperationType<Senders, ChildReceiver<Indices>>>...>;
+	};
+
+	std::tuple<Senders...> m_senders;
+	Receiver m_receiver;
+	typename Operations<std::index_sequence_for<Senders...>>::type m_operations;
+	std::tuple<std::optional<FStoredValue<typename Senders::ValueType>>...> m_values;
+	std::atomic_size_t m_remaining;
+	std::atomic_bool m_failed;
+	std::exception_ptr m_error;
+
+	void complete()
+	{
+		if (this->m_remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		if (this->m_failed)
+			this->m_receiver.setError(this->m_error);
+		else
+			this->m_receiver.setValue(std::apply([] (auto &... values) { return std::make_tuple(std::move(*values)...); }, this->m_values));
+	}
+
+	template<size_t... Indices>
+	void startAll(std::index_sequence<Indices...>)
+	{
+		(std::get<Indices>(this->m_operations).emplace(FInPlace{[this] {
+			return std::get<Indices>(this->m_senders).connect(ChildReceiver<Indices>{this});
+		}}), ...);
+
+		// the operation may be destroyed as soon as the last child completes
+		(std::get<Indices>(this->m_operations)->start(), ...);
+	}
+
+public:
+
+	FWhenAllOperation(std::tuple<Senders...> senders, Receiver receiver) : m_senders(std::move(senders)), m_receiver(std::move(receiver))
+	{
+		this->m_remaining = sizeof...(Senders);
+		this->m_failed = false;
+	}
+
+	void start()
+	{
+		// without children there is nothing to wait for
+		if constexpr (sizeof...(Senders) == 0)
+			this->m_receiver.setValue(std::tuple<>());
+		else
+			this->startAll(std::index_sequence_for<Senders...>());
+	}
+};
+
+/**
+ * Sender completing with the values of all its child senders once every child has completed.
+ */
+template<typename... Senders>
+class FWhenAllSender
+{
+private:
+
+	std::tuple<Senders...> m_senders;
+
+public:
+
+	using ValueType = std::tuple<FStoredValue<typename Senders::ValueType>...>;
+
+	explicit FWhenAllSender(Senders... senders) : m_senders(std::move(senders)...)
+	{
+	}
+
+	template<typename Receiver>
+	FWhenAllOperation<Receiver, Senders...> connect(Receiver receiver)
+	{
+		return FWhenAllOperation<Receiver, Senders...>(this->m_senders, std::move(receiver));
+	}
+};
+
+/**
+ * Creates a sender that completes with a tuple of the values of the given senders once all of them have completed.
+ *
+ * <p>Senders without a value contribute {@link FNone} to the tuple. If any sender fails the first error is passed on
+ * after every sender has completed. Without senders it completes immediately with an empty tuple.</p>
+ *
+ * @param senders The senders that are started together.
+ *
+ * @return the sender.
+ */
+template<typename... Senders>
+FWhenAllSender<Senders...> whenAll(Senders... senders)
+{
+	return FWhenAllSender<Senders...>(std::move(senders)...);
+}
+
+
+//---------------------------------------------------------------------------//
+//                         syncWait and startDetached                        //
+//---------------------------------------------------------------------------//
+
+template<typename Value>
+struct FSyncWaitState
+{
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool done = false;
+	std::optional<FStoredValue<Value>> value;
+	std::exception_ptr error;
+};
+
+template<typename Value>
+struct FSyncWaitReceiver
+{
+	FSyncWaitState<Value> *state;
+
+	template<typename... Values>
+	void setValue(Values &&... values)
+	{
+		std::lock_guard<std::mutex> lock(this->state->mutex);
+		if constexpr (!std::is_void_v<Value>)
+			this->state->value.emplace(std::forward<Values>(values)...);
+		this->state->done = true;
+		this->state->condition.notify_one();
+	}
+
+	void setError(std::exception_ptr error)
+	{
+		std::lock_guard<std::mutex> lock(this->state->mutex);
+		this->state->error = error;
+		this->state->done = true;
+		this->state->condition.notify_one();
+	}
+};
+
+/**
+ * Starts the given sender and blocks until it has completed.
+ *
+ * <p>Must not be called from an FThread the sender needs to complete on, that FThread would wait for itself.</p>
+ *
+ * @param sender The sender that will be started.
+ *
+ * @return the value of the sender.
+ *
+ * @throws the exception the sender completed with.
+ */
+template<typename Sender>
+typename Sender::ValueType syncWait(Sender sender)
+{
+	using Value = typename Sender::ValueType;
+
+	FSyncWaitState<Value> state;
+	auto operation = sender.connect(FSyncWaitReceiver<Value>{&state});
+	operation.start();
+
+	std::unique_lock<std::mutex> lock(state.mutex);
+	state.condition.wait(lock, [&state] { return state.done; });
+
+	if (state.error)
+		std::rethrow_exception(state.error);
+
+	if constexpr (!std::is_void_v<Value>)
+		return std::move(*state.value);
+}
+
+template<typename Sender>
+struct FDetachedOperation;
+
+template<typename Sender>
+struct FDetachedReceiver
+{
+	FDetachedOperation<Sender> *holder;
+
+	template<typename... Values>
+	void setValue(Values &&...)
+	{
+		delete this->holder;
+	}
+
+	void setError(std::exception_ptr)
+	{
+		delete this->holder;
+	}
+};
+
+template<typename Sender>
+struct FDetachedOperation
+{
+	Sender sender;
+	std::optional<FOperationType<Sender, FDetachedReceiver<Sender>>> operation;
+};
+
+/**
+ * Starts the given sender without waiting for it.
+ *
+ * <p>The operation state is allocated once and freed when the sender completes. Errors are dropped.</p>
+ *
+ * @param sender The sender that will be started.
+ */
+template<typename Sender>
+void startDetached(Sender sender)
+{
+	auto *holder = new FDetachedOperation<Sender>{std::move(sender), std::nullopt};
+	holder->operation.emplace(FInPlace{[holder] { return holder->sender.connect(FDetachedReceiver<Sender>{holder}); }});
+	holder->operation->start();
+}
+
+
+#endif /* CORE_CONCURRENT_FEXECUTOR_HPP_ */
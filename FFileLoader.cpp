@@ -0,0 +1,716 @@
+/*
+ * FFileLoader.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FFileLoader.hpp"
+#include "FLogger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define FFILELOADER_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+/**
+ * The number of reads that can be submitted to io_uring at the same time.
+ */
+static constexpr unsigned int IO_URING_ENTRIES = 64;
+
+/**
+ * The maximum size of a single read.
+ */
+static constexpr size_t MAX_READ_SIZE = 1ul << 30;
+
+/**
+ * How long the loader waits for io_uring completions before checking for new requests.
+ */
+static constexpr std::chrono::microseconds IO_URING_WAIT_TIME = std::chrono::microseconds(1000);
+
+
+//---------------------------------------------------------------------------//
+//                                IO Uring Class                             //
+//---------------------------------------------------------------------------//
+
+#ifdef FFILELOADER_IO_URING
+/**
+ * Minimal io_uring instance using the raw system calls, so no library is needed.
+ *
+ * <p>Only used by the loader FThread, so the submission queue has a single producer and the completion queue a single
+ * consumer.</p>
+ */
+class FIoUring
+{
+private:
+
+	int m_descriptor;
+	unsigned int m_entries;
+	/**
+	 * The number of prepared entries that have not been submitted yet.
+	 */
+	unsigned int m_prepared;
+	void *m_submissionRing;
+	size_t m_submissionRingSize;
+	void *m_completionRing;
+	size_t m_completionRingSize;
+	io_uring_sqe *m_submissionEntries;
+	unsigned int *m_submissionHead;
+	unsigned int *m_submissionTail;
+	unsigned int *m_submissionMask;
+	unsigned int *m_submissionArray;
+	unsigned int *m_completionHead;
+	unsigned int *m_completionTail;
+	unsigned int *m_completionMask;
+	io_uring_cqe *m_completionEntries;
+
+	FIoUring() = default;
+
+	int enter(const unsigned int minComplete, const unsigned int flags, void *argument, const size_t argumentSize)
+	{
+		long result = syscall(__NR_io_uring_enter, this->m_descriptor, this->m_prepared, minComplete, flags, argument, argumentSize);
+		if (result > 0)
+			this->m_prepared -= static_cast<unsigned int>(result);
+		return static_cast<int>(result);
+	}
+
+public:
+
+	/**
+	 * Creates a new io_uring instance.
+	 *
+	 * @param entries The number of entries of the submission queue.
+	 *
+	 * @return a pointer to the instance or <code>nullptr</code> if io_uring is not available.
+	 */
+	static FIoUring *create(const unsigned int entries)
+	{
+		io_uring_params params{};
+		long descriptor = syscall(__NR_io_uring_setup, entries, &params);
+		if (descriptor < 0)
+			return nullptr;
+
+		// waiting with a timeout needs IORING_ENTER_EXT_ARG, every opcode used here is older than that
+		if ((params.features & IORING_FEAT_EXT_ARG) == 0)
+		{
+			close(static_cast<int>(descriptor));
+			return nullptr;
+		}
+
+		auto *ring = new FIoUring();
+		ring->m_descriptor = static_cast<int>(descriptor);
+		ring->m_entries = params.sq_entries;
+		ring->m_prepared = 0;
+		ring->m_submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+		ring->m_completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+		bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (singleMap)
+		{
+			ring->m_submissionRingSize = std::max(ring->m_submissionRingSize, ring->m_completionRingSize);
+			ring->m_completionRingSize = ring->m_submissionRingSize;
+		}
+
+		ring->m_submissionRing = mmap(nullptr, ring->m_submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+				ring->m_descriptor, IORING_OFF_SQ_RING);
+		ring->m_completionRing = singleMap ? ring->m_submissionRing :
+				mmap(nullptr, ring->m_completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->m_descriptor,
+						IORING_OFF_CQ_RING);
+		void *submissionEntries = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, ring->m_descriptor, IORING_OFF_SQES);
+
+		if (ring->m_submissionRing == MAP_FAILED || ring->m_completionRing == MAP_FAILED || submissionEntries == MAP_FAILED)
+		{
+			if (ring->m_submissionRing != MAP_FAILED)
+				munmap(ring->m_submissionRing, ring->m_submissionRingSize);
+			if (!singleMap && ring->m_completionRing != MAP_FAILED)
+				munmap(ring->m_completionRing, ring->m_completionRingSize);
+			if (submissionEntries != MAP_FAILED)
+				munmap(submissionEntries, params.sq_entries * sizeof(io_uring_sqe));
+			close(ring->m_descriptor);
+			delete ring;
+			return nullptr;
+		}
+
+		auto *submissionRing = static_cast<char *>(ring->m_submissionRing);
+		auto *completionRing = static_cast<char *>(ring->m_completionRing);
+		ring->m_submissionEntries = static_cast<io_uring_sqe *>(submissionEntries);
+		ring->m_submissionHead = reinterpret_cast<unsigned int *>(submissionRing + params.sq_off.head);
+		ring->m_submissionTail = reinterpret_cast<unsigned int *>(submissionRing + params.sq_off.tail);
+		ring->m_submissionMask = reinterpret_cast<unsigned int *>(submissionRing + params.sq_off.ring_mask);
+		ring->m_submissionArray = reinterpret_cast<unsigned int *>(submissionRing + params.sq_off.array);
+		ring->m_completionHead = reinterpret_cast<unsigned int *>(completionRing + params.cq_off.head);
+		ring->m_completionTail = reinterpret_cast<unsigned int *>(completionRing + params.cq_off.tail);
+		ring->m_completionMask = reinterpret_cast<unsigned int *>(completionRing + params.cq_off.ring_mask);
+		ring->m_completionEntries = reinterpret_cast<io_uring_cqe *>(completionRing + params.cq_off.cqes);
+		return ring;
+	}
+
+	~FIoUring()
+	{
+		munmap(this->m_submissionEntries, this->m_entries * sizeof(io_uring_sqe));
+		if (this->m_completionRing != this->m_submissionRing)
+			munmap(this->m_completionRing, this->m_completionRingSize);
+		munmap(this->m_submissionRing, this->m_submissionRingSize);
+		close(this->m_descriptor);
+	}
+
+	/**
+	 * Prepares a read, it is submitted with the next call to {@link #wait()}.
+	 *
+	 * @return <code>false</code> if the submission queue is full.
+	 */
+	bool prepareRead(const int descriptor, void *buffer, const unsigned int size, const unsigned long offset, const void *userData)
+	{
+		unsigned int tail = *this->m_submissionTail;
+		if (tail - __atomic_load_n(this->m_submissionHead, __ATOMIC_ACQUIRE) >= this->m_entries)
+			return false;
+
+		unsigned int index = tail & *this->m_submissionMask;
+		io_uring_sqe *entry = &this->m_submissionEntries[index];
+		std::memset(entry, 0, sizeof(io_uring_sqe));
+		entry->opcode = IORING_OP_READ;
+		entry->fd = descriptor;
+		entry->addr = reinterpret_cast<unsigned long>(buffer);
+		entry->len = size;
+		entry->off = offset;
+		entry->user_data = reinterpret_cast<unsigned long>(userData);
+		this->m_submissionArray[index] = index;
+		__atomic_store_n(this->m_submissionTail, tail + 1, __ATOMIC_RELEASE);
+		this->m_prepared++;
+		return true;
+	}
+
+	/**
+	 * Submits every prepared read and waits until a read completes or the timeout expires.
+	 */
+	void wait(const std::chrono::microseconds &timeout)
+	{
+		__kernel_timespec time{};
+		time.tv_sec = timeout.count() / 1000000;
+		time.tv_nsec = (timeout.count() % 1000000) * 1000;
+		io_uring_getevents_arg argument{};
+		argument.ts = reinterpret_cast<unsigned long>(&time);
+		this->enter(1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &argument, sizeof(argument));
+	}
+
+	/**
+	 * Calls the given function with the user data and the result of every completed read.
+	 */
+	template<typename Function>
+	void reap(Function function)
+	{
+		unsigned int head = *this->m_completionHead;
+		unsigned int tail = __atomic_load_n(this->m_completionTail, __ATOMIC_ACQUIRE);
+		while (head != tail)
+		{
+			const io_uring_cqe &entry = this->m_completionEntries[head & *this->m_completionMask];
+			unsigned long userData = entry.user_data;
+			int result = entry.res;
+			head++;
+			// the entry is released before the function runs, which may prepare the next read
+			__atomic_store_n(this->m_completionHead, head, __ATOMIC_RELEASE);
+			function(reinterpret_cast<void *>(userData), result);
+			tail = __atomic_load_n(this->m_completionTail, __ATOMIC_ACQUIRE);
+		}
+	}
+
+	[[nodiscard]] unsigned int getEntries() const
+	{
+		return this->m_entries;
+	}
+};
+#else
+/**
+ * Placeholder on platforms without io_uring, {@link #create()} always fails.
+ */
+class FIoUring
+{
+public:
+
+	static FIoUring *create(unsigned int)
+	{
+		return nullptr;
+	}
+
+	bool prepareRead(int, void *, unsigned int, unsigned long, const void *)
+	{
+		return false;
+	}
+
+	void wait(const std::chrono::microseconds &)
+	{
+	}
+
+	template<typename Function>
+	void reap(Function)
+	{
+	}
+
+	[[nodiscard]] unsigned int getEntries() const
+	{
+		return 0;
+	}
+};
+#endif
+
+
+//---------------------------------------------------------------------------//
+//                               File Loader Class                           //
+//---------------------------------------------------------------------------//
+
+FFileLoader::Worker::Worker(const std::string &name, FFileLoader *loader) : FThread(name, -1.0, QUEUE_DISABLED)
+{
+	this->m_loader = loader;
+}
+
+void FFileLoader::Worker::onStart()
+{
+}
+
+void FFileLoader::Worker::onTick(const unsigned long, const unsigned long)
+{
+	Request *request = this->m_loader->takeRead(this);
+	if (request != nullptr)
+		this->m_loader->read(request);
+	else
+		this->m_clock->sleepUntil(&this->m_sleeper, FClock::FOREVER);
+}
+
+void FFileLoader::Worker::onStop()
+{
+}
+
+FFileLoader::FFileLoader(const std::string &name, const bool useIoUring, const unsigned int workerCount, const size_t readAheadLimit)
+		: FThread(name, -1.0, QUEUE_DISABLED)
+{
+	this->m_requestMutex.setName(name + "::m_requestMutex");
+	this->m_nextRequest = 1;
+	this->m_inFlight = 0;
+	this->m_readAheadSize = 0;
+	this->m_readAheadLimit = readAheadLimit;
+	this->m_ring = nullptr;
+	this->m_useIoUring = useIoUring;
+	this->m_workerCount = std::max(workerCount, 1u);
+}
+
+FFileLoader::~FFileLoader()
+{
+	for (auto &entry : this->m_requests)
+	{
+		if (entry.second->descriptor >= 0)
+			close(entry.second->descriptor);
+		delete entry.second;
+	}
+
+	for (Worker *worker : this->m_workers)
+		delete worker;
+}
+
+void FFileLoader::onStart()
+{
+	if (this->m_useIoUring)
+		this->m_ring = FIoUring::create(IO_URING_ENTRIES);
+
+	if (this->m_ring == nullptr)
+	{
+		if (this->m_useIoUring)
+			FLogger::info(this->m_name, "io_uring is not available, reading files with {} workers", this->m_workerCount);
+
+		for (unsigned int n = 0; n < this->m_workerCount; n++)
+		{
+			auto *worker = new Worker(this->m_name + "-" + std::to_string(n), this);
+			this->m_workers.push_back(worker);
+			this->m_workerThreads.push_back(worker->start());
+		}
+	}
+}
+
+void FFileLoader::onTick(const unsigned long, const unsigned long)
+{
+	std::vector<Request *> pendingRequests;
+	std::vector<Request *> finishedReads;
+	this->m_requestMutex.lock();
+	pendingRequests.swap(this->m_pendingRequests);
+	finishedReads.swap(this->m_finishedReads);
+	this->m_requestMutex.unlock();
+
+	for (Request *request : finishedReads)
+	{
+		this->m_inFlight--;
+		this->complete(request);
+	}
+
+	if (this->m_ring != nullptr)
+		this->reapIoUring();
+
+	for (Request *request : pendingRequests)
+		this->begin(request);
+
+	while (!this->m_backlog.empty() && this->submit(this->m_backlog.front()))
+		this->m_backlog.pop_front();
+
+	if (this->m_ring != nullptr && this->m_inFlight > 0)
+	{
+		// every read prepared during this tick is submitted with this single call
+		this->m_ring->wait(IO_URING_WAIT_TIME);
+		this->reapIoUring();
+	}
+	else
+	{
+		// new requests and finished reads wake the loader up
+		this->m_clock->sleepUntil(&this->m_sleeper, FClock::FOREVER);
+	}
+}
+
+void FFileLoader::onStop()
+{
+	for (Worker *worker : this->m_workers)
+		worker->stop();
+	for (std::thread *thread : this->m_workerThreads)
+	{
+		thread->join();
+		delete thread;
+	}
+	this->m_workerThreads.clear();
+	for (Worker *worker : this->m_workers)
+		delete worker;
+	this->m_workers.clear();
+
+	if (this->m_ring != nullptr)
+	{
+		// the kernel may still write into the buffers of submitted reads
+		while (this->m_inFlight > 0)
+		{
+			this->m_ring->wait(IO_URING_WAIT_TIME);
+			this->m_ring->reap([this] (void *, int) {
+				this->m_inFlight--;
+			});
+		}
+		delete this->m_ring;
+		this->m_ring = nullptr;
+	}
+
+	// the callbacks of unfinished requests are never executed
+	this->m_requestMutex.lock();
+	for (auto &entry : this->m_requests)
+	{
+		if (entry.second->descriptor >= 0)
+			close(entry.second->descriptor);
+		delete entry.second;
+	}
+	this->m_requests.clear();
+	this->m_pendingRequests.clear();
+	this->m_readQueue.clear();
+	this->m_idleWorkers.clear();
+	this->m_finishedReads.clear();
+	this->m_requestMutex.unlock();
+
+	this->m_backlog.clear();
+	this->m_activeReads.clear();
+	this->m_inFlight = 0;
+	this->m_readAheadCache.clear();
+	this->m_readAheadOrder.clear();
+	this->m_readAheadSize = 0;
+}
+
+void FFileLoader::begin(Request *request)
+{
+	if (request->cancelled)
+	{
+		this->deliver(request, nullptr);
+		return;
+	}
+
+	auto cached = this->m_readAheadCache.find(request->path);
+	if (cached != this->m_readAheadCache.end())
+	{
+		if (request->readAhead)
+		{
+			this->deliver(request, nullptr);
+			return;
+		}
+
+		// files read ahead are handed out once
+		std::shared_ptr<FFileData> file = cached->second;
+		this->m_readAheadSize -= file->data.size();
+		this->m_readAheadCache.erase(cached);
+		this->m_readAheadOrder.erase(std::find(this->m_readAheadOrder.begin(), this->m_readAheadOrder.end(), request->path));
+		this->deliver(request, file);
+		return;
+	}
+
+	auto active = this->m_activeReads.find(request->path);
+	if (active != this->m_activeReads.end())
+	{
+		if (request->readAhead)
+			this->deliver(request, nullptr);
+		else
+			active->second->followers.push_back(request);
+		return;
+	}
+
+	this->m_activeReads[request->path] = request;
+	request->file = std::make_shared<FFileData>();
+	request->file->path = request->path;
+	if (!this->m_backlog.empty() || !this->submit(request))
+		this->m_backlog.push_back(request);
+}
+
+bool FFileLoader::submit(Request *request)
+{
+	if (this->m_ring == nullptr)
+	{
+		// only an idle worker is woken, a busy one would leave the read queued behind its current read
+		Worker *idleWorker = nullptr;
+		this->m_requestMutex.lock();
+		this->m_readQueue.push_back(request);
+		if (!this->m_idleWorkers.empty())
+		{
+			idleWorker = this->m_idleWorkers.back();
+			this->m_idleWorkers.pop_back();
+		}
+		this->m_requestMutex.unlock();
+
+		this->m_inFlight++;
+		if (idleWorker != nullptr)
+			idleWorker->wake();
+		return true;
+	}
+
+	if (this->m_inFlight >= this->m_ring->getEntries())
+		return false;
+
+	if (request->descriptor < 0)
+	{
+		if (!this->open(request) || request->file->data.empty())
+		{
+			this->complete(request);
+			return true;
+		}
+	}
+
+	size_t size = std::min(request->file->data.size() - request->offset, MAX_READ_SIZE);
+	if (!this->m_ring->prepareRead(request->descriptor, request->file->data.data() + request->offset, static_cast<unsigned int>(size),
+			request->offset, request))
+		return false;
+
+	this->m_inFlight++;
+	return true;
+}
+
+bool FFileLoader::open(Request *request)
+{
+	request->descriptor = ::open(request->path.c_str(), O_RDONLY | O_CLOEXEC);
+	struct stat status{};
+	if (request->descriptor < 0 || fstat(request->descriptor, &status) != 0)
+	{
+		request->file->error = errno;
+		FLogger::warning(this->m_name, "could not open {}, errno: {}", request->path, request->file->error);
+		return false;
+	}
+
+	request->file->data.resize(static_cast<size_t>(status.st_size));
+	return true;
+}
+
+FFileLoader::Request *FFileLoader::takeRead(Worker *worker)
+{
+	Request *request = nullptr;
+	this->m_requestMutex.lock();
+	auto idle = std::find(this->m_idleWorkers.begin(), this->m_idleWorkers.end(), worker);
+	if (!this->m_readQueue.empty())
+	{
+		request = this->m_readQueue.front();
+		this->m_readQueue.pop_front();
+		if (idle != this->m_idleWorkers.end())
+			this->m_idleWorkers.erase(idle);
+	}
+	else if (idle == this->m_idleWorkers.end())
+	{
+		// a wake between here and the sleep of the worker is not lost, the sleeper remembers it
+		this->m_idleWorkers.push_back(worker);
+	}
+	this->m_requestMutex.unlock();
+	return request;
+}
+
+void FFileLoader::read(Request *request)
+{
+	if (this->open(request))
+	{
+		std::vector<char> &data = request->file->data;
+		while (request->offset < data.size())
+		{
+			ssize_t result = pread(request->descriptor, data.data() + request->offset,
+					std::min(data.size() - request->offset, MAX_READ_SIZE), static_cast<off_t>(request->offset));
+			if (result < 0 && errno == EINTR)
+				continue;
+			if (result < 0)
+			{
+				request->file->error = errno;
+				break;
+			}
+			// the file shrank since it was opened
+			if (result == 0)
+			{
+				data.resize(request->offset);
+				break;
+			}
+			request->offset += static_cast<size_t>(result);
+		}
+	}
+
+	this->m_requestMutex.lock();
+	this->m_finishedReads.push_back(request);
+	this->m_requestMutex.unlock();
+	this->wake();
+}
+
+void FFileLoader::reapIoUring()
+{
+	this->m_ring->reap([this] (void *userData, const int result) {
+		auto *request = static_cast<Request *>(userData);
+		this->m_inFlight--;
+
+		if (result == -EINTR || result == -EAGAIN)
+		{
+			this->m_backlog.push_front(request);
+			return;
+		}
+
+		if (result < 0)
+			request->file->error = -result;
+		else if (result == 0)
+			request->file->data.resize(request->offset);
+		else
+			request->offset += static_cast<size_t>(result);
+
+		if (result > 0 && request->offset < request->file->data.size())
+		{
+			if (!this->submit(request))
+				this->m_backlog.push_front(request);
+		}
+		else
+		{
+			this->complete(request);
+		}
+	});
+}
+
+void FFileLoader::complete(Request *request)
+{
+	if (request->descriptor >= 0)
+	{
+		close(request->descriptor);
+		request->descriptor = -1;
+	}
+	this->m_activeReads.erase(request->path);
+
+	std::shared_ptr<FFileData> file = request->file;
+	if (file->error != 0)
+		file->data.clear();
+
+	if (request->readAhead && request->followers.empty() && file->error == 0 && !request->cancelled)
+		this->cache(file);
+
+	for (Request *follower : request->followers)
+		this->deliver(follower, file);
+	request->followers.clear();
+	this->deliver(request, file);
+}
+
+void FFileLoader::deliver(Request *request, const std::shared_ptr<FFileData> &file)
+{
+	this->m_requestMutex.lock();
+	this->m_requests.erase(request->id);
+	bool cancelled = request->cancelled;
+	this->m_requestMutex.unlock();
+
+	if (!cancelled && !request->readAhead && file != nullptr)
+	{
+		if (request->target != nullptr)
+		{
+			FFileCallback callback = request->callback;
+			request->target->addTask([callback, file] {
+				callback(file);
+			});
+		}
+		else
+		{
+			request->callback(file);
+		}
+	}
+	delete request;
+}
+
+void FFileLoader::cache(const std::shared_ptr<FFileData> &file)
+{
+	if (file->data.size() > this->m_readAheadLimit)
+		return;
+
+	while (this->m_readAheadSize + file->data.size() > this->m_readAheadLimit)
+	{
+		auto oldest = this->m_readAheadCache.find(this->m_readAheadOrder.front());
+		this->m_readAheadSize -= oldest->second->data.size();
+		this->m_readAheadCache.erase(oldest);
+		this->m_readAheadOrder.pop_front();
+	}
+
+	this->m_readAheadCache[file->path] = file;
+	this->m_readAheadOrder.push_back(file->path);
+	this->m_readAheadSize += file->data.size();
+}
+
+unsigned long FFileLoader::enqueue(const std::string &path, const FFileCallback &callback, FThread *target, const bool readAhead)
+{
+	auto *request = new Request();
+	unsigned long id = this->m_nextRequest++;
+	request->id = id;
+	request->path = path;
+	request->callback = callback;
+	request->target = target;
+	request->readAhead = readAhead;
+
+	this->m_requestMutex.lock();
+	this->m_requests[request->id] = request;
+	this->m_pendingRequests.push_back(request);
+	this->m_requestMutex.unlock();
+
+	this->wake();
+	return id;
+}
+
+unsigned long FFileLoader::load(const std::string &path, const FFileCallback &callback, FThread *target)
+{
+	return this->enqueue(path, callback, target, false);
+}
+
+void FFileLoader::readAhead(const std::string &path)
+{
+	this->enqueue(path, nullptr, nullptr, true);
+}
+
+bool FFileLoader::cancel(const unsigned long request)
+{
+	std::lock_guard<FMutex> lock(this->m_requestMutex);
+	auto entry = this->m_requests.find(request);
+	if (entry == this->m_requests.end())
+		return false;
+
+	entry->second->cancelled = true;
+	return true;
+}
+
+bool FFileLoader::isUsingIoUring() const
+{
+	return this->m_ring != nullptr;
+}
@@ -0,0 +1,331 @@
+/*
+ * FFileLoader.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FFILELOADER_HPP_
+#define CORE_CONCURRENT_FFILELOADER_HPP_
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <memory>
+#include <functional>
+#include <atomic>
+
+#include "FThread.hpp"
+
+class FIoUring;
+
+/**
+ * The content of a file loaded by an {@link FFileLoader}.
+ */
+struct FFileData
+{
+	/**
+	 * The path of the file.
+	 */
+	std::string path;
+	/**
+	 * The content of the file.
+	 */
+	std::vector<char> data;
+	/**
+	 * Zero if the file has been loaded, otherwise the errno of the failed operation.
+	 */
+	int error = 0;
+};
+
+/**
+ * Function receiving a loaded file.
+ */
+typedef std::function<void(const std::shared_ptr<FFileData> &)> FFileCallback;
+
+/**
+ * FThread loading files asynchronously.
+ *
+ * <p>Reads are batched through io_uring on Linux when it is available and otherwise executed by a small pool of worker
+ * FThreads. The loaded file is handed to the FThread that requested it through its task queue, so the callback runs on
+ * the requesting FThread right before its next tick and never blocks it while reading.</p>
+ *
+ * <p>Files can be read ahead with {@link #readAhead()}, a later {@link #load()} of the same path is served from memory or
+ * joins the read in progress.</p>
+ */
+class FFileLoader : public FThread
+{
+private:
+
+	/**
+	 * A request to load a file.
+	 */
+	struct Request
+	{
+		unsigned long id;
+		std::string path;
+		FFileCallback callback;
+		FThread *target;
+		bool readAhead;
+		std::atomic_bool cancelled{false};
+		std::shared_ptr<FFileData> file;
+		int descriptor = -1;
+		size_t offset = 0;
+		/**
+		 * Requests for the same path that wait for this read.
+		 */
+		std::vector<Request *> followers;
+	};
+
+	/**
+	 * Worker FThread reading files when io_uring is not available.
+	 */
+	class Worker : public FThread
+	{
+	private:
+
+		/**
+		 * A pointer to the loader of the worker.
+		 */
+		FFileLoader *m_loader;
+
+	protected:
+
+		void onStart() override;
+
+		void onTick(unsigned long currentTime, unsigned long currentTick) override;
+
+		void onStop() override;
+
+	public:
+
+		Worker(const std::string &name, FFileLoader *loader);
+	};
+
+	/**
+	 * Mutex for {@link #m_pendingRequests}, {@link #m_requests}, {@link #m_readQueue}, {@link #m_idleWorkers} and
+	 * {@link #m_finishedReads}.
+	 */
+	FMutex m_requestMutex;
+	/**
+	 * The requests that have not been seen by the loader yet.
+	 */
+	std::vector<Request *> m_pendingRequests;
+	/**
+	 * Every request that has not been finished yet by its id.
+	 */
+	std::unordered_map<unsigned long, Request *> m_requests;
+	/**
+	 * The reads waiting for a worker.
+	 */
+	std::deque<Request *> m_readQueue;
+	/**
+	 * The workers that found the read queue empty and sleep until they are woken for the next read.
+	 */
+	std::vector<Worker *> m_idleWorkers;
+	/**
+	 * The reads the workers have finished.
+	 */
+	std::vector<Request *> m_finishedReads;
+	/**
+	 * The id of the next request.
+	 */
+	std::atomic_ulong m_nextRequest;
+	/**
+	 * Reads that could not be submitted yet because io_uring was full.
+	 */
+	std::deque<Request *> m_backlog;
+	/**
+	 * The reads in progress by their path.
+	 */
+	std::unordered_map<std::string, Request *> m_activeReads;
+	/**
+	 * The number of reads submitted to io_uring or the workers.
+	 */
+	size_t m_inFlight;
+	/**
+	 * Files that have been read ahead by their path.
+	 */
+	std::unordered_map<std::string, std::shared_ptr<FFileData>> m_readAheadCache;
+	/**
+	 * The paths in {@link #m_readAheadCache}, the oldest first.
+	 */
+	std::deque<std::string> m_readAheadOrder;
+	/**
+	 * The number of bytes in {@link #m_readAheadCache}.
+	 */
+	size_t m_readAheadSize;
+	/**
+	 * The maximum number of bytes in {@link #m_readAheadCache}.
+	 */
+	size_t m_readAheadLimit;
+	/**
+	 * Whether io_uring is used when it is available.
+	 */
+	bool m_useIoUring;
+	/**
+	 * The io_uring instance or <code>nullptr</code> if the workers read the files.
+	 */
+	FIoUring *m_ring;
+	/**
+	 * The number of workers used when io_uring is not available.
+	 */
+	unsigned int m_workerCount;
+	/**
+	 * A list with pointers to the workers.
+	 */
+	std::vector<Worker *> m_workers;
+	/**
+	 * The std::threads of the workers.
+	 */
+	std::vector<std::thread *> m_workerThreads;
+
+	/**
+	 * Starts reading the file of a request or serves it from the read ahead cache.
+	 *
+	 * @param request A pointer to the request.
+	 */
+	void begin(Request *request);
+
+	/**
+	 * Submits the read of a request to io_uring or a worker.
+	 *
+	 * @param request A pointer to the request.
+	 *
+	 * @return <code>false</code> if io_uring is full.
+	 */
+	bool submit(Request *request);
+
+	/**
+	 * Opens the file of a request and allocates its buffer.
+	 *
+	 * @param request A pointer to the request.
+	 *
+	 * @return <code>false</code> if the file could not be opened, the error is stored in the file of the request.
+	 */
+	bool open(Request *request);
+
+	/**
+	 * Takes the next read from the queue of the workers, marking the given worker idle if the queue is empty.
+	 *
+	 * @param worker A pointer to the calling worker.
+	 *
+	 * @return a pointer to the request or <code>nullptr</code> if the queue is empty.
+	 */
+	Request *takeRead(Worker *worker);
+
+	/**
+	 * Reads the file of a request on the calling worker.
+	 *
+	 * @param request A pointer to the request.
+	 */
+	void read(Request *request);
+
+	/**
+	 * Handles the completed io_uring reads.
+	 */
+	void reapIoUring();
+
+	/**
+	 * Finishes a read and delivers the file to the request and its followers.
+	 *
+	 * @param request A pointer to the request.
+	 */
+	void complete(Request *request);
+
+	/**
+	 * Delivers a file to the FThread of a request and deletes the request.
+	 *
+	 * @param request A pointer to the request.
+	 * @param file The loaded file.
+	 */
+	void deliver(Request *request, const std::shared_ptr<FFileData> &file);
+
+	/**
+	 * Adds a file to the read ahead cache, evicting the oldest files if necessary.
+	 *
+	 * @param file The file.
+	 */
+	void cache(const std::shared_ptr<FFileData> &file);
+
+	/**
+	 * Queues a new request.
+	 *
+	 * @return the id of the request.
+	 */
+	unsigned long enqueue(const std::string &path, const FFileCallback &callback, FThread *target, bool readAhead);
+
+protected:
+
+	void onStart() override;
+
+	void onTick(unsigned long currentTime, unsigned long currentTick) override;
+
+	void onStop() override;
+
+public:
+
+	/**
+	 * Constructs a new FFileLoader.
+	 *
+	 * @param name A reference to the name of the loader.
+	 * @param useIoUring Whether io_uring is used when it is available.
+	 * @param workerCount The number of workers reading the files when io_uring is not used, at least one.
+	 * @param readAheadLimit The maximum number of bytes kept in memory by {@link #readAhead()}.
+	 */
+	explicit FFileLoader(const std::string &name = "FFileLoader", bool useIoUring = true, unsigned int workerCount = 2,
+			size_t readAheadLimit = 64 * 1024 * 1024);
+
+	/**
+	 * Destroys the FFileLoader.
+	 */
+	~FFileLoader() override;
+
+	/**
+	 * Loads a file asynchronously.
+	 *
+	 * <p>The callback is added to the task queue of the target FThread once the file has been loaded or failed to load, see
+	 * {@link FFileData#error}. Without a target it is executed on the loader itself. The target must outlive the request.</p>
+	 *
+	 * @param path A reference to the path of the file.
+	 * @param callback The function receiving the file.
+	 * @param target A pointer to the FThread the callback is executed on, the calling FThread by default.
+	 *
+	 * @return the id of the request, which can be passed to {@link #cancel()}.
+	 */
+	unsigned long load(const std::string &path, const FFileCallback &callback, FThread *target = FThread::getCurrentThread());
+
+	/**
+	 * Reads a file ahead of its use.
+	 *
+	 * <p>The next {@link #load()} of the path is served from memory. Files read ahead are dropped once they were loaded or
+	 * when they exceed the read ahead limit.</p>
+	 *
+	 * @param path A reference to the path of the file.
+	 */
+	void readAhead(const std::string &path);
+
+	/**
+	 * Cancels a request.
+	 *
+	 * <p>The callback of a cancelled request is never executed.</p>
+	 *
+	 * @param request The id of the request.
+	 *
+	 * @return <code>false</code> if the request has finished already.
+	 */
+	bool cancel(unsigned long request);
+
+	/**
+	 * Gets whether the files are read through io_uring.
+	 *
+	 * <p>Only valid once the loader has started.</p>
+	 *
+	 * @return <code>true</code> when io_uring is used.
+	 */
+	[[nodiscard]] bool isUsingIoUring() const;
+};
+
+
+#endif /* CORE_CONCURRENT_FFILELOADER_HPP_ */
@@ -0,0 +1,171 @@
+/*
+ * FGLState.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FGLState.hpp"
+
+
+//---------------------------------------------------------------------------//
+//                               GL State Class                              //
+//---------------------------------------------------------------------------//
+
+FGLState::FGLState()
+{
+	this->m_program = UNKNOWN;
+	this->m_vertexArray = UNKNOWN;
+	this->m_buffers = std::vector<std::pair<GLenum, uint32_t>>();
+	this->m_activeTexture = UNKNOWN;
+	this->m_textures = std::vector<TextureBinding>();
+	this->m_capabilities = std::vector<std::pair<GLenum, bool>>();
+	this->m_issuedCalls = 0;
+	this->m_filteredCalls = 0;
+	this->m_lastIssuedCalls = 0;
+	this->m_lastFilteredCalls = 0;
+}
+
+void FGLState::invalidate()
+{
+	this->m_program = UNKNOWN;
+	this->m_vertexArray = UNKNOWN;
+	this->m_buffers.clear();
+	this->m_activeTexture = UNKNOWN;
+	this->m_textures.clear();
+	this->m_capabilities.clear();
+}
+
+void FGLState::invalidateBuffers()
+{
+	this->m_buffers.clear();
+}
+
+void FGLState::useProgram(const uint32_t program)
+{
+	if (this->m_program == program)
+	{
+		this->m_filteredCalls++;
+		return;
+	}
+
+	glUseProgram(program);
+	this->m_program = program;
+	this->m_issuedCalls++;
+}
+
+void FGLState::bindVertexArray(const uint32_t vertexArray)
+{
+	if (this->m_vertexArray == vertexArray)
+	{
+		this->m_filteredCalls++;
+		return;
+	}
+
+	glBindVertexArray(vertexArray);
+	this->m_vertexArray = vertexArray;
+	this->m_issuedCalls++;
+}
+
+void FGLState::bindBuffer(const GLenum target, const uint32_t buffer)
+{
+	std::pair<GLenum, uint32_t> *binding = nullptr;
+	for (std::pair<GLenum, uint32_t> &bufferBinding : this->m_buffers)
+	{
+		if (bufferBinding.first == target)
+			binding = &bufferBinding;
+	}
+
+	if (binding != nullptr && binding->second == buffer)
+	{
+		this->m_filteredCalls++;
+		return;
+	}
+
+	glBindBuffer(target, buffer);
+	this->m_issuedCalls++;
+
+	// stored in the bound vertex array object, so it changes with every vertex array object
+	if (target == GL_ELEMENT_ARRAY_BUFFER)
+		return;
+
+	if (binding != nullptr)
+		binding->second = buffer;
+	else
+		this->m_buffers.emplace_back(target, buffer);
+}
+
+void FGLState::bindTexture(const unsigned int unit, const GLenum target, const uint32_t texture)
+{
+	TextureBinding *binding = nullptr;
+	for (TextureBinding &textureBinding : this->m_textures)
+	{
+		if (textureBinding.unit == unit && textureBinding.target == target)
+			binding = &textureBinding;
+	}
+
+	if (binding != nullptr && binding->texture == texture)
+	{
+		this->m_filteredCalls++;
+		return;
+	}
+
+	if (this->m_activeTexture != unit)
+	{
+		glActiveTexture(GL_TEXTURE0 + unit);
+		this->m_activeTexture = unit;
+		this->m_issuedCalls++;
+	}
+	glBindTexture(target, texture);
+	this->m_issuedCalls++;
+
+	if (binding != nullptr)
+		binding->texture = texture;
+	else
+		this->m_textures.push_back({unit, target, texture});
+}
+
+void FGLState::setEnabled(const GLenum capability, const bool enabled)
+{
+	std::pair<GLenum, bool> *state = nullptr;
+	for (std::pair<GLenum, bool> &capabilityState : this->m_capabilities)
+	{
+		if (capabilityState.first == capability)
+			state = &capabilityState;
+	}
+
+	if (state != nullptr && state->second == enabled)
+	{
+		this->m_filteredCalls++;
+		return;
+	}
+
+	if (enabled)
+		glEnable(capability);
+	else
+		glDisable(capability);
+	this->m_issuedCalls++;
+
+	if (state != nullptr)
+		state->second = enabled;
+	else
+		this->m_capabilities.emplace_back(capability, enabled);
+}
+
+void FGLState::endFrame()
+{
+	this->m_lastIssuedCalls = this->m_issuedCalls;
+	this->m_lastFilteredCalls = this->m_filteredCalls;
+	this->m_issuedCalls = 0;
+	this->m_filteredCalls = 0;
+}
+
+unsigned long FGLState::getIssuedCalls() const
+{
+	return this->m_lastIssuedCalls;
+}
+
+unsigned long FGLState::getFilteredCalls() const
+{
+	return this->m_lastFilteredCalls;
+}
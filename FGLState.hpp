@@ -0,0 +1,166 @@
+/*
+ * FGLState.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FGLSTATE_HPP_
+#define CORE_CONCURRENT_FGLSTATE_HPP_
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "glad/glad.h"
+
+/**
+ * Class tracking the bindings and capabilities of a GL context to filter redundant state changes.
+ *
+ * <p>Every state change goes through the tracker, which only issues the GL call if it changes the value the context
+ * already has, so binding the same program or vertex array object for every draw call costs no driver call. The issued
+ * and filtered calls are counted per frame.</p>
+ *
+ * <p>The tracker only knows the state changed through it. After GL calls that change the state behind its back, e.g.
+ * deleting a bound object or code binding objects itself, {@link #invalidate()} or {@link #invalidateBuffers()} makes the
+ * next changes be issued again. The binding of <code>GL_ELEMENT_ARRAY_BUFFER</code> belongs to the vertex array object
+ * and is never filtered. A tracker belongs to a single context and must only be used while that context is current.</p>
+ */
+class FGLState
+{
+private:
+
+	/**
+	 * A texture bound to a target of a texture unit.
+	 */
+	struct TextureBinding
+	{
+		unsigned int unit;
+		GLenum target;
+		uint32_t texture;
+	};
+
+	/**
+	 * The program in use, {@link #UNKNOWN} if it is not known.
+	 */
+	uint32_t m_program;
+	/**
+	 * The bound vertex array object, {@link #UNKNOWN} if it is not known.
+	 */
+	uint32_t m_vertexArray;
+	/**
+	 * The buffers bound to their targets, targets not listed are not known.
+	 */
+	std::vector<std::pair<GLenum, uint32_t>> m_buffers;
+	/**
+	 * The active texture unit, {@link #UNKNOWN} if it is not known.
+	 */
+	uint32_t m_activeTexture;
+	/**
+	 * The textures bound to the targets of the texture units, bindings not listed are not known.
+	 */
+	std::vector<TextureBinding> m_textures;
+	/**
+	 * The capabilities and whether they are enabled, capabilities not listed are not known.
+	 */
+	std::vector<std::pair<GLenum, bool>> m_capabilities;
+	/**
+	 * The number of calls issued during the current frame.
+	 */
+	unsigned long m_issuedCalls;
+	/**
+	 * The number of calls filtered during the current frame.
+	 */
+	unsigned long m_filteredCalls;
+	/**
+	 * The number of calls issued during the last frame.
+	 */
+	unsigned long m_lastIssuedCalls;
+	/**
+	 * The number of calls filtered during the last frame.
+	 */
+	unsigned long m_lastFilteredCalls;
+
+public:
+
+	/**
+	 * The value of a binding that is not known.
+	 */
+	static constexpr uint32_t UNKNOWN = 0xFFFFFFFF;
+
+	/**
+	 * Constructs a new FGLState that does not know any state yet.
+	 */
+	FGLState();
+
+	/**
+	 * Forgets the whole state, so the next change of every binding and capability is issued.
+	 */
+	void invalidate();
+
+	/**
+	 * Forgets the bound buffers, so the next buffer binding of every target is issued.
+	 */
+	void invalidateBuffers();
+
+	/**
+	 * Uses a program, see <code>glUseProgram</code>.
+	 *
+	 * @param program The name of the program.
+	 */
+	void useProgram(uint32_t program);
+
+	/**
+	 * Binds a vertex array object, see <code>glBindVertexArray</code>.
+	 *
+	 * @param vertexArray The name of the vertex array object.
+	 */
+	void bindVertexArray(uint32_t vertexArray);
+
+	/**
+	 * Binds a buffer to a target, see <code>glBindBuffer</code>.
+	 *
+	 * @param target The target, <code>GL_ELEMENT_ARRAY_BUFFER</code> is always issued.
+	 * @param buffer The name of the buffer.
+	 */
+	void bindBuffer(GLenum target, uint32_t buffer);
+
+	/**
+	 * Binds a texture to a target of a texture unit, see <code>glActiveTexture</code> and <code>glBindTexture</code>.
+	 *
+	 * @param unit The index of the texture unit, starting at 0.
+	 * @param target The target, e.g. <code>GL_TEXTURE_2D</code>.
+	 * @param texture The name of the texture.
+	 */
+	void bindTexture(unsigned int unit, GLenum target, uint32_t texture);
+
+	/**
+	 * Enables or disables a capability, see <code>glEnable</code> and <code>glDisable</code>.
+	 *
+	 * @param capability The capability, e.g. <code>GL_CULL_FACE</code>.
+	 * @param enabled Whether the capability is enabled.
+	 */
+	void setEnabled(GLenum capability, bool enabled);
+
+	/**
+	 * Ends a frame, making its counters available through {@link #getIssuedCalls()} and {@link #getFilteredCalls()}.
+	 */
+	void endFrame();
+
+	/**
+	 * Gets the number of state changes issued to the driver during the last frame.
+	 *
+	 * @return the number of issued calls.
+	 */
+	[[nodiscard]] unsigned long getIssuedCalls() const;
+
+	/**
+	 * Gets the number of redundant state changes filtered during the last frame.
+	 *
+	 * @return the number of filtered calls.
+	 */
+	[[nodiscard]] unsigned long getFilteredCalls() const;
+};
+
+
+#endif /* CORE_CONCURRENT_FGLSTATE_HPP_ */
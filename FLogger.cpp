@@ -0,0 +1,519 @@
+/*
+ * FLogger.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FLogger.hpp"
+#include "FThread.hpp"
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+
+/**
+ * The number of bytes of a message that store the source and the string arguments.
+ */
+static constexpr size_t TEXT_SIZE = 192;
+
+/**
+ * Log message with its unformatted arguments.
+ */
+struct FLogRecord
+{
+	/**
+	 * Argument of a message with strings stored in {@link FLogRecord#text}.
+	 */
+	struct Argument
+	{
+		FLogArgument::Type type;
+		union
+		{
+			long long signedValue;
+			unsigned long long unsignedValue;
+			double floatingValue;
+		};
+		unsigned short offset;
+		unsigned short length;
+	};
+
+	unsigned long long timestamp;
+	FLogLevel level;
+	const char *format;
+	unsigned long suppressed;
+	unsigned int argumentCount;
+	unsigned short sourceLength;
+	Argument arguments[FLogger::MAX_ARGUMENTS];
+	char text[TEXT_SIZE];
+};
+
+/**
+ * Lock-free ring buffer with the messages of one thread.
+ *
+ * <p>Only the owning thread adds messages and only the flusher removes them.</p>
+ */
+struct FLogRing
+{
+	/**
+	 * The number of messages the ring can hold.
+	 */
+	static constexpr size_t CAPACITY = 256;
+	/**
+	 * The number of messages the rate limit keeps track of.
+	 */
+	static constexpr size_t RATE_LIMITS = 16;
+
+	/**
+	 * Rate limit state of one message, only accessed by the owning thread.
+	 */
+	struct RateLimit
+	{
+		const char *format = nullptr;
+		size_t source = 0;
+		unsigned long long windowStart = 0;
+		unsigned int count = 0;
+		unsigned long suppressed = 0;
+	};
+
+	FLogRecord records[CAPACITY];
+	RateLimit rateLimits[RATE_LIMITS];
+	/**
+	 * The index of the next message the flusher removes.
+	 */
+	alignas(CACHE_LINE_SIZE) std::atomic_size_t head{0};
+	/**
+	 * The index of the next message the owning thread adds.
+	 */
+	alignas(CACHE_LINE_SIZE) std::atomic_size_t tail{0};
+	/**
+	 * The number of messages dropped because the ring was full.
+	 */
+	std::atomic_ulong dropped{0};
+	/**
+	 * Whether the owning thread has finished, the ring is deleted once it is empty.
+	 */
+	std::atomic_bool orphaned{false};
+
+	/**
+	 * Checks whether a message passes the rate limit.
+	 *
+	 * @param format The format string of the message.
+	 * @param source The hash of the source of the message.
+	 * @param now The current time in microseconds.
+	 * @param limit The number of messages per second that pass.
+	 * @param suppressed The number of suppressed repetitions that are reported with this message.
+	 *
+	 * @return <code>true</code> when the message passes.
+	 */
+	bool admit(const char *format, const size_t source, const unsigned long long now, const unsigned int limit, unsigned long &suppressed)
+	{
+		RateLimit *rateLimit = nullptr;
+		RateLimit *oldest = &this->rateLimits[0];
+		for (RateLimit &candidate : this->rateLimits)
+		{
+			if (candidate.format == format && candidate.source == source)
+			{
+				rateLimit = &candidate;
+				break;
+			}
+			if (candidate.windowStart < oldest->windowStart)
+				oldest = &candidate;
+		}
+
+		if (rateLimit == nullptr)
+		{
+			rateLimit = oldest;
+			*rateLimit = RateLimit();
+			rateLimit->format = format;
+			rateLimit->source = source;
+			rateLimit->windowStart = now;
+		}
+		else if (now - rateLimit->windowStart >= 1000000)
+		{
+			rateLimit->windowStart = now;
+			rateLimit->count = 0;
+		}
+
+		if (rateLimit->count >= limit)
+		{
+			rateLimit->suppressed++;
+			return false;
+		}
+
+		rateLimit->count++;
+		suppressed = rateLimit->suppressed;
+		rateLimit->suppressed = 0;
+		return true;
+	}
+};
+
+/**
+ * Marks the ring of a thread as orphaned when the thread finishes.
+ */
+struct FLogRingOwner
+{
+	FLogRing *ring = nullptr;
+
+	~FLogRingOwner()
+	{
+		if (this->ring != nullptr)
+			this->ring->orphaned.store(true, std::memory_order_release);
+	}
+};
+
+/**
+ * FThread writing the buffered messages.
+ */
+class FLogFlusher : public FThread
+{
+protected:
+
+	void onStart() override
+	{
+	}
+
+	void onTick(const unsigned long, const unsigned long) override
+	{
+		FLogger::flush();
+	}
+
+	void onStop() override;
+
+public:
+
+	explicit FLogFlusher(const double flushesPerSecond) : FThread("FLogger", flushesPerSecond, QUEUE_DISABLED)
+	{
+	}
+};
+
+
+//---------------------------------------------------------------------------//
+//                                Logger Class                               //
+//---------------------------------------------------------------------------//
+
+/**
+ * List with pointers to the rings of all threads that logged.
+ */
+static std::vector<FLogRing *> *RINGS = new std::vector<FLogRing *>();
+/**
+ * Mutex for the {@link #RINGS} list and the output.
+ */
+static std::mutex *FLUSH_MUTEX = new std::mutex();
+/**
+ * Mutex for starting and stopping the flusher.
+ */
+static std::mutex *FLUSHER_MUTEX = new std::mutex();
+/**
+ * The flusher or <code>nullptr</code>.
+ */
+static FLogFlusher *FLUSHER = nullptr;
+/**
+ * The std::thread of the flusher or <code>nullptr</code>.
+ */
+static std::thread *FLUSHER_THREAD = nullptr;
+/**
+ * Whether messages are buffered for the flusher or written right away.
+ */
+static std::atomic_bool ASYNCHRONOUS(false);
+/**
+ * The stream messages are written to.
+ */
+static std::atomic<std::ostream *> OUTPUT(&std::cout);
+/**
+ * The minimum level of the messages that are logged.
+ */
+static std::atomic<FLogLevel> LEVEL(LOG_TRACE);
+/**
+ * How many repetitions of the same warning or error per second pass, zero disables rate limiting.
+ */
+static std::atomic_uint RATE_LIMIT(5);
+/**
+ * The messages dropped by rings that have been deleted already.
+ */
+static std::atomic_ulong DROPPED(0);
+/**
+ * The number of dropped messages reported so far.
+ */
+static unsigned long REPORTED_DROPPED = 0;
+/**
+ * The ring of the calling thread.
+ */
+static thread_local FLogRingOwner RING_OWNER;
+
+static const char *getLevelName(const FLogLevel level)
+{
+	switch (level)
+	{
+		case LOG_TRACE:
+			return "TRACE";
+		case LOG_INFO:
+			return "INFO";
+		case LOG_WARNING:
+			return "WARNING";
+		default:
+			return "ERROR";
+	}
+}
+
+static FLogRing *getRing()
+{
+	FLogRing *ring = RING_OWNER.ring;
+	if (ring == nullptr)
+	{
+		ring = new FLogRing();
+		FLUSH_MUTEX->lock();
+		RINGS->push_back(ring);
+		FLUSH_MUTEX->unlock();
+		RING_OWNER.ring = ring;
+	}
+	return ring;
+}
+
+static void storeRecord(FLogRecord &record, const FLogLevel level, const std::string &source, const char *format,
+		const FLogArgument *arguments, const unsigned int argumentCount, const unsigned long long timestamp, const unsigned long suppressed)
+{
+	record.timestamp = timestamp;
+	record.level = level;
+	record.format = format;
+	record.suppressed = suppressed;
+	record.argumentCount = argumentCount;
+
+	size_t used = std::min(source.size(), TEXT_SIZE);
+	std::memcpy(record.text, source.data(), used);
+	record.sourceLength = static_cast<unsigned short>(used);
+
+	for (unsigned int n = 0; n < argumentCount; n++)
+	{
+		FLogRecord::Argument &argument = record.arguments[n];
+		argument.type = arguments[n].type;
+		if (argument.type == FLogArgument::STRING)
+		{
+			// strings that do not fit anymore are truncated
+			size_t length = std::min(arguments[n].length, TEXT_SIZE - used);
+			std::memcpy(record.text + used, arguments[n].string, length);
+			argument.offset = static_cast<unsigned short>(used);
+			argument.length = static_cast<unsigned short>(length);
+			used += length;
+		}
+		else if (argument.type == FLogArgument::FLOATING)
+		{
+			argument.floatingValue = arguments[n].floatingValue;
+		}
+		else
+		{
+			argument.unsignedValue = arguments[n].unsignedValue;
+		}
+	}
+}
+
+static void formatRecord(const FLogRecord &record, std::string &output)
+{
+	output += '[';
+	output.append(record.text, record.sourceLength);
+	output += "][";
+	output += getLevelName(record.level);
+	output += "]: ";
+
+	unsigned int argument = 0;
+	for (const char *character = record.format; *character != '\0'; character++)
+	{
+		if (character[0] != '{' || character[1] != '}' || argument >= record.argumentCount)
+		{
+			output += *character;
+			continue;
+		}
+
+		const FLogRecord::Argument &value = record.arguments[argument++];
+		switch (value.type)
+		{
+			case FLogArgument::SIGNED:
+				output += std::to_string(value.signedValue);
+				break;
+			case FLogArgument::UNSIGNED:
+				output += std::to_string(value.unsignedValue);
+				break;
+			case FLogArgument::FLOATING:
+				output += std::to_string(value.floatingValue);
+				break;
+			case FLogArgument::STRING:
+				output.append(record.text + value.offset, value.length);
+				break;
+		}
+		character++;
+	}
+
+	if (record.suppressed > 0)
+		output += " (" + std::to_string(record.suppressed) + " similar messages suppressed)";
+	output += '\n';
+}
+
+/**
+ * Writes the messages of every ring.
+ *
+ * <p>{@link #FLUSH_MUTEX} must be locked when calling this function.</p>
+ */
+static void flushRings()
+{
+	static std::vector<FLogRecord> batch;
+	static std::string output;
+	batch.clear();
+	output.clear();
+
+	unsigned long dropped = 0;
+	auto it = RINGS->begin();
+	while (it != RINGS->end())
+	{
+		FLogRing *ring = *it;
+		bool orphaned = ring->orphaned.load(std::memory_order_acquire);
+		size_t head = ring->head.load(std::memory_order_relaxed);
+		size_t tail = ring->tail.load(std::memory_order_acquire);
+		for (; head != tail; head++)
+			batch.push_back(ring->records[head % FLogRing::CAPACITY]);
+		ring->head.store(head, std::memory_order_release);
+
+		if (orphaned)
+		{
+			DROPPED += ring->dropped.load(std::memory_order_relaxed);
+			delete ring;
+			it = RINGS->erase(it);
+		}
+		else
+		{
+			dropped += ring->dropped.load(std::memory_order_relaxed);
+			it++;
+		}
+	}
+	dropped += DROPPED.load(std::memory_order_relaxed);
+	std::stable_sort(batch.begin(), batch.end(), [] (const FLogRecord &first, const FLogRecord &second) {
+		return first.timestamp < second.timestamp;
+	});
+	for (const FLogRecord &record : batch)
+		formatRecord(record, output);
+
+	if (dropped > REPORTED_DROPPED)
+	{
+		output += "[FLogger][WARNING]: " + std::to_string(dropped - REPORTED_DROPPED) + " messages dropped because a log buffer was full\n";
+		REPORTED_DROPPED = dropped;
+	}
+
+	if (!output.empty())
+	{
+		std::ostream *stream = OUTPUT.load();
+		stream->write(output.data(), static_cast<std::streamsize>(output.size()));
+		stream->flush();
+	}
+}
+
+void FLogFlusher::onStop()
+{
+	// messages logged after the flusher stopped, e.g. by FThread::stopAll(), are written right away
+	ASYNCHRONOUS = false;
+	FLogger::flush();
+}
+
+void FLogger::log(const FLogLevel level, const std::string &source, const char *format, const FLogArgument *arguments,
+		const unsigned int argumentCount)
+{
+	if (level < LEVEL.load(std::memory_order_relaxed))
+		return;
+
+	FLogRing *ring = getRing();
+	unsigned long long now = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+
+	unsigned long suppressed = 0;
+	unsigned int rateLimit = RATE_LIMIT.load(std::memory_order_relaxed);
+	if (level >= LOG_WARNING && rateLimit > 0 && !ring->admit(format, std::hash<std::string>()(source), now, rateLimit, suppressed))
+		return;
+
+	if (!ASYNCHRONOUS.load(std::memory_order_acquire))
+	{
+		FLogRecord record;
+		storeRecord(record, level, source, format, arguments, argumentCount, now, suppressed);
+
+		std::string output;
+		formatRecord(record, output);
+
+		// buffered messages are written first to keep the order
+		std::lock_guard<std::mutex> lock(*FLUSH_MUTEX);
+		flushRings();
+		std::ostream *stream = OUTPUT.load();
+		stream->write(output.data(), static_cast<std::streamsize>(output.size()));
+		stream->flush();
+		return;
+	}
+
+	size_t tail = ring->tail.load(std::memory_order_relaxed);
+	if (tail - ring->head.load(std::memory_order_acquire) >= FLogRing::CAPACITY)
+	{
+		ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return;
+	}
+
+	storeRecord(ring->records[tail % FLogRing::CAPACITY], level, source, format, arguments, argumentCount, now, suppressed);
+	ring->tail.store(tail + 1, std::memory_order_release);
+}
+
+bool FLogger::start(const double flushesPerSecond)
+{
+	std::lock_guard<std::mutex> lock(*FLUSHER_MUTEX);
+	if (FLUSHER != nullptr)
+		return false;
+
+	FLUSHER = new FLogFlusher(flushesPerSecond);
+	ASYNCHRONOUS = true;
+	FLUSHER_THREAD = FLUSHER->start();
+	return true;
+}
+
+void FLogger::stop()
+{
+	std::lock_guard<std::mutex> lock(*FLUSHER_MUTEX);
+	if (FLUSHER == nullptr)
+		return;
+
+	ASYNCHRONOUS = false;
+	FLUSHER->stop();
+	FLUSHER_THREAD->join();
+	delete FLUSHER_THREAD;
+	delete FLUSHER;
+	FLUSHER_THREAD = nullptr;
+	FLUSHER = nullptr;
+
+	flush();
+}
+
+void FLogger::flush()
+{
+	std::lock_guard<std::mutex> lock(*FLUSH_MUTEX);
+	flushRings();
+}
+
+void FLogger::setOutput(std::ostream *output)
+{
+	OUTPUT = output;
+}
+
+void FLogger::setLevel(const FLogLevel level)
+{
+	LEVEL = level;
+}
+
+void FLogger::setRateLimit(const unsigned int messagesPerSecond)
+{
+	RATE_LIMIT = messagesPerSecond;
+}
+
+unsigned long FLogger::getDroppedMessages()
+{
+	std::lock_guard<std::mutex> lock(*FLUSH_MUTEX);
+	unsigned long dropped = DROPPED.load(std::memory_order_relaxed);
+	for (const FLogRing *ring : *RINGS)
+		dropped += ring->dropped.load(std::memory_order_relaxed);
+	return dropped;
+}
@@ -0,0 +1,210 @@
+/*
+ * FLogger.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FLOGGER_HPP_
+#define CORE_CONCURRENT_FLOGGER_HPP_
+
+#include <string>
+#include <ostream>
+#include <atomic>
+#include <type_traits>
+
+/**
+ * Enum defining the severity of a log message.
+ */
+enum FLogLevel
+{
+	LOG_TRACE,
+	LOG_INFO,
+	LOG_WARNING,
+	LOG_ERROR
+};
+
+/**
+ * Argument of a log message that is stored unformatted until the message is written.
+ *
+ * <p>Strings are copied into the message when it is logged, so they do not have to outlive the call.</p>
+ */
+class FLogArgument
+{
+public:
+
+	/**
+	 * Enum defining the type of the argument.
+	 */
+	enum Type
+	{
+		SIGNED,
+		UNSIGNED,
+		FLOATING,
+		STRING
+	};
+
+	Type type;
+	union
+	{
+		long long signedValue;
+		unsigned long long unsignedValue;
+		double floatingValue;
+	};
+	/**
+	 * The string of a {@link #STRING} argument, only valid during the log call.
+	 */
+	const char *string = nullptr;
+	/**
+	 * The length of {@link #string}.
+	 */
+	size_t length = 0;
+
+	template<typename T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T>, int> = 0>
+	FLogArgument(T value) : type(SIGNED), signedValue(value)
+	{
+	}
+
+	template<typename T, std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T>, int> = 0>
+	FLogArgument(T value) : type(UNSIGNED), unsignedValue(value)
+	{
+	}
+
+	FLogArgument(double value) : type(FLOATING), floatingValue(value)
+	{
+	}
+
+	FLogArgument(const char *value) : type(STRING), unsignedValue(0), string(value), length(std::char_traits<char>::length(value))
+	{
+	}
+
+	FLogArgument(const std::string &value) : type(STRING), unsignedValue(0), string(value.data()), length(value.size())
+	{
+	}
+};
+
+/**
+ * Class writing log messages asynchronously.
+ *
+ * <p>Every thread logs into its own lock-free ring buffer. Messages keep their format string and arguments unformatted
+ * until a background flusher FThread started with {@link #start()} formats and writes them, so logging never waits for
+ * the output. Messages are dropped and counted when the ring of a thread is full. Before the flusher is started and after
+ * it is stopped messages are written synchronously.</p>
+ *
+ * <p>Format strings use <code>{}</code> as placeholder for the next argument and must be string literals, since only the
+ * pointer is stored. Repetitions of the same warning or error from the same source and thread are rate limited, the number
+ * of suppressed messages is appended to the next message that passes.</p>
+ *
+ * <p>{@link #stop()} should be called before the program exits, otherwise messages still buffered are lost.</p>
+ */
+class FLogger
+{
+public:
+
+	/**
+	 * The maximum number of arguments of a message.
+	 */
+	static constexpr unsigned int MAX_ARGUMENTS = 6;
+
+	/**
+	 * Logs a message.
+	 *
+	 * @param level The {@link FLogLevel} of the message.
+	 * @param source A reference to the name of the source, e.g. the name of an FThread.
+	 * @param format The format string of the message.
+	 * @param arguments A pointer array to the arguments of the message.
+	 * @param argumentCount The number of arguments.
+	 */
+	static void log(FLogLevel level, const std::string &source, const char *format, const FLogArgument *arguments, unsigned int argumentCount);
+
+	template<typename... Arguments>
+	static void trace(const std::string &source, const char *format, const Arguments &... arguments)
+	{
+		logArguments(LOG_TRACE, source, format, arguments...);
+	}
+
+	template<typename... Arguments>
+	static void info(const std::string &source, const char *format, const Arguments &... arguments)
+	{
+		logArguments(LOG_INFO, source, format, arguments...);
+	}
+
+	template<typename... Arguments>
+	static void warning(const std::string &source, const char *format, const Arguments &... arguments)
+	{
+		logArguments(LOG_WARNING, source, format, arguments...);
+	}
+
+	template<typename... Arguments>
+	static void error(const std::string &source, const char *format, const Arguments &... arguments)
+	{
+		logArguments(LOG_ERROR, source, format, arguments...);
+	}
+
+	/**
+	 * Starts the flusher FThread.
+	 *
+	 * @param flushesPerSecond How often the buffered messages are written.
+	 *
+	 * @return <code>false</code> if the flusher is running already.
+	 */
+	static bool start(double flushesPerSecond = 20.0);
+
+	/**
+	 * Stops the flusher FThread and writes the remaining messages.
+	 */
+	static void stop();
+
+	/**
+	 * Writes every buffered message.
+	 */
+	static void flush();
+
+	/**
+	 * Sets the stream messages are written to.
+	 *
+	 * @param output A pointer to the stream, std::cout by default.
+	 */
+	static void setOutput(std::ostream *output);
+
+	/**
+	 * Sets the minimum level of the messages that are logged.
+	 *
+	 * @param level The minimum {@link FLogLevel}.
+	 */
+	static void setLevel(FLogLevel level);
+
+	/**
+	 * Sets how many repetitions of the same warning or error per second pass the rate limit.
+	 *
+	 * @param messagesPerSecond The number of messages per second, zero disables rate limiting.
+	 */
+	static void setRateLimit(unsigned int messagesPerSecond);
+
+	/**
+	 * Gets the number of messages that were dropped because a ring was full.
+	 *
+	 * @return the number of dropped messages.
+	 */
+	[[nodiscard]] static unsigned long getDroppedMessages();
+
+private:
+
+	template<typename... Arguments>
+	static void logArguments(FLogLevel level, const std::string &source, const char *format, const Arguments &... arguments)
+	{
+		static_assert(sizeof...(Arguments) <= MAX_ARGUMENTS, "too many log arguments");
+		if constexpr (sizeof...(Arguments) == 0)
+		{
+			log(level, source, format, nullptr, 0);
+		}
+		else
+		{
+			const FLogArgument logArguments[] = {FLogArgument(arguments)...};
+			log(level, source, format, logArguments, sizeof...(Arguments));
+		}
+	}
+};
+
+
+#endif /* CORE_CONCURRENT_FLOGGER_HPP_ */
@@ -0,0 +1,210 @@
+/*
+ * FMutex.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FMutex.hpp"
+
+#ifdef FTHREAD_INSTRUMENT_LOCKS
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+
+/**
+ * Gets the list with pointers to all FMutexes.
+ *
+ * <p>Created on first use, so FMutexes can be constructed during static initialization.</p>
+ */
+static std::vector<FMutex *> &getMutexes()
+{
+	static std::vector<FMutex *> mutexes;
+	return mutexes;
+}
+
+/**
+ * Gets the mutex for the list returned by {@link #getMutexes()} and the names of the FMutexes.
+ */
+static std::mutex &getMutexesMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+/**
+ * Increments a counter that is only written while the owning FMutex is locked.
+ */
+static inline void increment(std::atomic_ulong &counter)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+
+//---------------------------------------------------------------------------//
+//                            Lock Histogram Class                           //
+//---------------------------------------------------------------------------//
+
+FLockHistogram::FLockHistogram()
+{
+	this->reset();
+}
+
+void FLockHistogram::record(const unsigned long nanoseconds)
+{
+	unsigned int bucket = 0;
+	while (bucket < BUCKETS - 1 && (nanoseconds >> (bucket + 1)) != 0)
+		bucket++;
+	increment(this->m_buckets[bucket]);
+}
+
+void FLockHistogram::reset()
+{
+	for (std::atomic_ulong &bucket : this->m_buckets)
+		bucket.store(0, std::memory_order_relaxed);
+}
+
+unsigned long FLockHistogram::getCount() const
+{
+	unsigned long count = 0;
+	for (const std::atomic_ulong &bucket : this->m_buckets)
+		count += bucket.load(std::memory_order_relaxed);
+	return count;
+}
+
+unsigned long FLockHistogram::getPercentile(const double percentile) const
+{
+	unsigned long count = this->getCount();
+	if (count == 0)
+		return 0;
+
+	auto rank = static_cast<unsigned long>(percentile / 100.0 * static_cast<double>(count));
+	unsigned long seen = 0;
+	for (unsigned int bucket = 0; bucket < BUCKETS; bucket++)
+	{
+		seen += this->m_buckets[bucket].load(std::memory_order_relaxed);
+		if (seen > rank || seen == count)
+			return 2ul << bucket;
+	}
+	return 2ul << (BUCKETS - 1);
+}
+
+
+//---------------------------------------------------------------------------//
+//                                 Mutex Class                               //
+//---------------------------------------------------------------------------//
+
+FMutex::FMutex(const std::string &name)
+{
+	this->m_name = name;
+	this->m_acquisitions = 0;
+	this->m_contendedAcquisitions = 0;
+
+	std::lock_guard<std::mutex> lock(getMutexesMutex());
+	getMutexes().push_back(this);
+}
+
+FMutex::~FMutex()
+{
+	std::lock_guard<std::mutex> lock(getMutexesMutex());
+	std::vector<FMutex *> &mutexes = getMutexes();
+	mutexes.erase(std::remove(mutexes.begin(), mutexes.end(), this), mutexes.end());
+}
+
+void FMutex::lock()
+{
+	if (!this->m_mutex.try_lock())
+	{
+		std::chrono::steady_clock::time_point waitBegin = std::chrono::steady_clock::now();
+		this->m_mutex.lock();
+		this->m_lockedAt = std::chrono::steady_clock::now();
+
+		increment(this->m_contendedAcquisitions);
+		this->m_waitTimes.record(std::chrono::duration_cast<std::chrono::nanoseconds>(this->m_lockedAt - waitBegin).count());
+	}
+	else
+	{
+		this->m_lockedAt = std::chrono::steady_clock::now();
+	}
+
+	increment(this->m_acquisitions);
+}
+
+bool FMutex::try_lock()
+{
+	if (!this->m_mutex.try_lock())
+		return false;
+
+	this->m_lockedAt = std::chrono::steady_clock::now();
+	increment(this->m_acquisitions);
+	return true;
+}
+
+void FMutex::unlock()
+{
+	this->m_holdTimes.record(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->m_lockedAt).count());
+	this->m_mutex.unlock();
+}
+
+void FMutex::setName(const std::string &name)
+{
+	std::lock_guard<std::mutex> lock(getMutexesMutex());
+	this->m_name = name;
+}
+
+void FMutex::reset()
+{
+	this->m_acquisitions = 0;
+	this->m_contendedAcquisitions = 0;
+	this->m_waitTimes.reset();
+	this->m_holdTimes.reset();
+}
+
+unsigned long FMutex::getAcquisitions() const
+{
+	return this->m_acquisitions;
+}
+
+unsigned long FMutex::getContendedAcquisitions() const
+{
+	return this->m_contendedAcquisitions;
+}
+
+const FLockHistogram &FMutex::getWaitTimes() const
+{
+	return this->m_waitTimes;
+}
+
+const FLockHistogram &FMutex::getHoldTimes() const
+{
+	return this->m_holdTimes;
+}
+
+void FMutex::printStatistics()
+{
+	std::lock_guard<std::mutex> lock(getMutexesMutex());
+	std::vector<FMutex *> mutexes;
+	for (FMutex *mutex : getMutexes())
+	{
+		if (mutex->getAcquisitions() > 0)
+			mutexes.push_back(mutex);
+	}
+
+	std::sort(mutexes.begin(), mutexes.end(), [] (const FMutex *first, const FMutex *second) {
+		return first->getContendedAcquisitions() > second->getContendedAcquisitions();
+	});
+
+	for (const FMutex *mutex : mutexes)
+	{
+		unsigned long acquisitions = mutex->getAcquisitions();
+		unsigned long contended = mutex->getContendedAcquisitions();
+		std::cout << "[" << mutex->m_name << "][LOCK]: acquisitions: " << acquisitions << ", contended: " << contended << " ("
+				  << 100.0 * static_cast<double>(contended) / static_cast<double>(acquisitions) << "%), wait p50/p99/max: "
+				  << mutex->m_waitTimes.getPercentile(50.0) << "/" << mutex->m_waitTimes.getPercentile(99.0) << "/"
+				  << mutex->m_waitTimes.getPercentile(100.0) << " ns, hold p50/p99/max: " << mutex->m_holdTimes.getPercentile(50.0) << "/"
+				  << mutex->m_holdTimes.getPercentile(99.0) << "/" << mutex->m_holdTimes.getPercentile(100.0) << " ns" << std::endl;
+	}
+}
+#endif
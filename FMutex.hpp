@@ -0,0 +1,244 @@
+/*
+ * FMutex.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FMUTEX_HPP_
+#define CORE_CONCURRENT_FMUTEX_HPP_
+
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <atomic>
+
+#ifdef FTHREAD_INSTRUMENT_LOCKS
+/**
+ * Histogram of durations with one bucket per power of two nanoseconds.
+ */
+class FLockHistogram
+{
+public:
+
+	/**
+	 * The number of buckets, the last bucket holds every duration longer than about nine minutes.
+	 */
+	static constexpr unsigned int BUCKETS = 40;
+
+private:
+
+	/**
+	 * The number of durations in every bucket.
+	 */
+	std::atomic_ulong m_buckets[BUCKETS];
+
+public:
+
+	FLockHistogram();
+
+	/**
+	 * Adds a duration to the histogram.
+	 *
+	 * <p>Must only be called while the owning {@link FMutex} is locked.</p>
+	 *
+	 * @param nanoseconds The duration in nanoseconds.
+	 */
+	void record(unsigned long nanoseconds);
+
+	/**
+	 * Removes every duration from the histogram.
+	 */
+	void reset();
+
+	/**
+	 * Gets the number of durations in the histogram.
+	 *
+	 * @return the number of durations.
+	 */
+	[[nodiscard]] unsigned long getCount() const;
+
+	/**
+	 * Gets the given percentile of the durations.
+	 *
+	 * @param percentile The percentile between zero and one hundred.
+	 *
+	 * @return the upper bound of the bucket containing the percentile in nanoseconds.
+	 */
+	[[nodiscard]] unsigned long getPercentile(double percentile) const;
+};
+
+/**
+ * Mutex recording acquisitions, contention, wait times and hold times.
+ *
+ * <p>Can be used wherever a std::mutex is used, together with std::condition_variable_any instead of
+ * std::condition_variable. Every FMutex registers itself by name, so the statistics of all locks can be printed at once
+ * with {@link #printStatistics()}.</p>
+ *
+ * <p>Instrumentation is only compiled in when <code>FTHREAD_INSTRUMENT_LOCKS</code> is defined, otherwise FMutex is a
+ * plain std::mutex.</p>
+ */
+class FMutex
+{
+private:
+
+	/**
+	 * The underlying mutex.
+	 */
+	std::mutex m_mutex;
+	/**
+	 * The name the statistics are printed with.
+	 */
+	std::string m_name;
+	/**
+	 * The number of times the mutex has been locked.
+	 */
+	std::atomic_ulong m_acquisitions;
+	/**
+	 * The number of times the mutex was locked by another thread when trying to lock it.
+	 */
+	std::atomic_ulong m_contendedAcquisitions;
+	/**
+	 * The times contended acquisitions waited for the mutex.
+	 */
+	FLockHistogram m_waitTimes;
+	/**
+	 * The times the mutex was held.
+	 */
+	FLockHistogram m_holdTimes;
+	/**
+	 * The time the current owner locked the mutex.
+	 */
+	std::chrono::steady_clock::time_point m_lockedAt;
+
+public:
+
+	/**
+	 * Whether locks are instrumented.
+	 */
+	static constexpr bool ENABLED = true;
+
+	/**
+	 * Constructs a new FMutex.
+	 *
+	 * @param name A reference to the name the statistics are printed with.
+	 */
+	explicit FMutex(const std::string &name = "unnamed");
+
+	/**
+	 * Destroys the FMutex.
+	 */
+	~FMutex();
+
+	FMutex(const FMutex &) = delete;
+
+	FMutex &operator=(const FMutex &) = delete;
+
+	/**
+	 * Locks the mutex.
+	 */
+	void lock();
+
+	/**
+	 * Tries to lock the mutex without waiting.
+	 *
+	 * @return <code>true</code> when the mutex has been locked.
+	 */
+	bool try_lock();
+
+	/**
+	 * Unlocks the mutex.
+	 */
+	void unlock();
+
+	/**
+	 * Sets the name the statistics are printed with.
+	 *
+	 * @param name A reference to the new name.
+	 */
+	void setName(const std::string &name);
+
+	/**
+	 * Resets the statistics of the mutex.
+	 */
+	void reset();
+
+	/**
+	 * Gets the number of times the mutex has been locked.
+	 *
+	 * @return the number of acquisitions.
+	 */
+	[[nodiscard]] unsigned long getAcquisitions() const;
+
+	/**
+	 * Gets the number of times the mutex was locked by another thread when trying to lock it.
+	 *
+	 * @return the number of contended acquisitions.
+	 */
+	[[nodiscard]] unsigned long getContendedAcquisitions() const;
+
+	/**
+	 * Gets the times contended acquisitions waited for the mutex.
+	 *
+	 * @return a const reference to the wait time histogram.
+	 */
+	[[nodiscard]] const FLockHistogram &getWaitTimes() const;
+
+	/**
+	 * Gets the times the mutex was held.
+	 *
+	 * @return a const reference to the hold time histogram.
+	 */
+	[[nodiscard]] const FLockHistogram &getHoldTimes() const;
+
+	/**
+	 * Prints the statistics of every FMutex that has been locked at least once, the most contended first.
+	 */
+	static void printStatistics();
+};
+#else
+class FMutex
+{
+private:
+
+	std::mutex m_mutex;
+
+public:
+
+	static constexpr bool ENABLED = false;
+
+	explicit FMutex(const std::string & = "")
+	{
+	}
+
+	FMutex(const FMutex &) = delete;
+
+	FMutex &operator=(const FMutex &) = delete;
+
+	void lock()
+	{
+		this->m_mutex.lock();
+	}
+
+	bool try_lock()
+	{
+		return this->m_mutex.try_lock();
+	}
+
+	void unlock()
+	{
+		this->m_mutex.unlock();
+	}
+
+	void setName(const std::string &)
+	{
+	}
+
+	static void printStatistics()
+	{
+	}
+};
+#endif
+
+
+#endif /* CORE_CONCURRENT_FMUTEX_HPP_ */
@@ -0,0 +1,192 @@
+/*
+ * FProgramCache.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FProgramCache.hpp"
+#include "FLogger.hpp"
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <cstring>
+#include <cstdio>
+
+
+/**
+ * The header in front of a stored program binary.
+ */
+struct ProgramBinaryHeader
+{
+	char magic[4];
+	uint32_t format;
+	uint64_t key;
+	uint32_t length;
+};
+
+static constexpr char BINARY_MAGIC[4] = {'F', 'P', 'C', '1'};
+
+/**
+ * Continues a 64 bit FNV-1a hash with the given string including its terminating zero, so consecutive strings cannot
+ * shift into each other.
+ */
+static uint64_t hashString(uint64_t hash, const char *string)
+{
+	size_t length = string != nullptr ? std::strlen(string) + 1 : 0;
+	for (size_t n = 0; n < length; n++)
+	{
+		hash ^= static_cast<unsigned char>(string[n]);
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+
+//---------------------------------------------------------------------------//
+//                             Program Cache Class                           //
+//---------------------------------------------------------------------------//
+
+FProgramCache::FProgramCache(const std::string &directory)
+{
+	this->m_directory = directory;
+	this->m_hits = 0;
+	this->m_misses = 0;
+}
+
+bool FProgramCache::isSupported()
+{
+	if (!GLAD_GL_VERSION_4_1)
+		return false;
+
+	GLint formats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	return formats > 0;
+}
+
+std::string FProgramCache::getPath(const char *vertexShaderSource, const char *fragmentShaderSource, uint64_t &key) const
+{
+	key = 0xcbf29ce484222325ULL;
+	key = hashString(key, vertexShaderSource);
+	key = hashString(key, fragmentShaderSource);
+	key = hashString(key, reinterpret_cast<const char *>(glGetString(GL_VENDOR)));
+	key = hashString(key, reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+	key = hashString(key, reinterpret_cast<const char *>(glGetString(GL_VERSION)));
+
+	char name[24];
+	std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+	return this->m_directory + "/" + name;
+}
+
+uint32_t FProgramCache::load(const char *vertexShaderSource, const char *fragmentShaderSource)
+{
+	if (!isSupported())
+		return 0;
+
+	uint64_t key;
+	std::string path = this->getPath(vertexShaderSource, fragmentShaderSource, key);
+
+	std::ifstream file(path, std::ios::binary);
+	ProgramBinaryHeader header{};
+	if (!file || !file.read(reinterpret_cast<char *>(&header), sizeof(header)) || std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0
+			|| header.key != key)
+	{
+		this->m_misses++;
+		return 0;
+	}
+
+	// a corrupted length would allocate up to 4 GiB before the read fails, so it must match the rest of the file
+	std::error_code error;
+	std::uintmax_t fileSize = std::filesystem::file_size(path, error);
+	if (error || fileSize < sizeof(header) || fileSize - sizeof(header) != header.length)
+	{
+		FLogger::warning("FProgramCache", "the length of the binary {} does not match its file, recompiling the program", path);
+		this->m_misses++;
+		return 0;
+	}
+
+	std::vector<char> binary(header.length);
+	if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size())))
+	{
+		this->m_misses++;
+		return 0;
+	}
+
+	uint32_t program = glCreateProgram();
+	glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+	// the driver rejects binaries of another build or hardware even if the version string did not change
+	GLint linked = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &linked);
+	if (linked != GL_TRUE)
+	{
+		FLogger::warning("FProgramCache", "the driver rejected the binary {}, recompiling the program", path);
+		glDeleteProgram(program);
+		this->m_misses++;
+		return 0;
+	}
+
+	this->m_hits++;
+	return program;
+}
+
+bool FProgramCache::store(const uint32_t program, const char *vertexShaderSource, const char *fragmentShaderSource)
+{
+	if (!isSupported())
+		return false;
+
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return false;
+
+	std::vector<char> binary(static_cast<size_t>(length));
+	GLenum format = 0;
+	glGetProgramBinary(program, length, &length, &format, binary.data());
+
+	uint64_t key;
+	std::string path = this->getPath(vertexShaderSource, fragmentShaderSource, key);
+	ProgramBinaryHeader header{};
+	std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+	header.format = format;
+	header.key = key;
+	header.length = static_cast<uint32_t>(length);
+
+	std::error_code error;
+	std::filesystem::create_directories(this->m_directory, error);
+
+	// written to a file of its own first, so a concurrent load never sees a partial binary
+	std::string temporaryPath = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(binary.data(), length);
+		if (!file)
+		{
+			FLogger::error("FProgramCache", "could not write {}!", temporaryPath);
+			file.close();
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+	}
+
+	std::filesystem::rename(temporaryPath, path, error);
+	if (error)
+	{
+		FLogger::error("FProgramCache", "could not write {}: {}", path, error.message());
+		std::filesystem::remove(temporaryPath, error);
+		return false;
+	}
+	return true;
+}
+
+unsigned long FProgramCache::getHits() const
+{
+	return this->m_hits;
+}
+
+unsigned long FProgramCache::getMisses() const
+{
+	return this->m_misses;
+}
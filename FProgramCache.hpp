@@ -0,0 +1,110 @@
+/*
+ * FProgramCache.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FPROGRAMCACHE_HPP_
+#define CORE_CONCURRENT_FPROGRAMCACHE_HPP_
+
+#include <string>
+#include <atomic>
+#include <cstdint>
+
+#include "glad/glad.h"
+
+/**
+ * Class storing linked GL programs on disk so later launches skip compiling and linking their shaders.
+ *
+ * <p>A program is stored as the binary returned by <code>glGetProgramBinary</code> in a file named after a hash of its
+ * shader sources and the vendor, renderer and version of the driver, so a changed shader or an updated driver never loads
+ * a stale binary. A binary the driver rejects is treated like a missing one and replaced by the next
+ * {@link #store()}.</p>
+ *
+ * <p>Program binaries need OpenGL 4.1 and a driver supporting at least one binary format, otherwise the cache never
+ * finds a program and stores nothing. All methods use the GL context current on the calling thread and may be called
+ * from several threads.</p>
+ */
+class FProgramCache
+{
+private:
+
+	/**
+	 * The directory the binaries are stored in.
+	 */
+	std::string m_directory;
+	/**
+	 * The number of programs that were loaded from the cache.
+	 */
+	std::atomic_ulong m_hits;
+	/**
+	 * The number of programs that were not found in the cache.
+	 */
+	std::atomic_ulong m_misses;
+
+	/**
+	 * Gets the path of the file storing the program linked from the given shaders by the current driver.
+	 *
+	 * @param vertexShaderSource The source of the vertex shader.
+	 * @param fragmentShaderSource The source of the fragment shader.
+	 * @param key A reference to the hash of the program, set by this method.
+	 * @return the path of the file.
+	 */
+	std::string getPath(const char *vertexShaderSource, const char *fragmentShaderSource, uint64_t &key) const;
+
+public:
+
+	/**
+	 * Constructs a new FProgramCache.
+	 *
+	 * @param directory A reference to the directory the binaries are stored in, it is created when the first binary is
+	 * 		stored.
+	 */
+	explicit FProgramCache(const std::string &directory);
+
+	/**
+	 * Gets whether the current context supports program binaries.
+	 *
+	 * @return <code>true</code> if programs can be loaded and stored.
+	 */
+	[[nodiscard]] static bool isSupported();
+
+	/**
+	 * Creates a program from the binary stored for the given shaders.
+	 *
+	 * @param vertexShaderSource The source of the vertex shader.
+	 * @param fragmentShaderSource The source of the fragment shader.
+	 * @return the name of the linked program, 0 if no valid binary is stored.
+	 */
+	uint32_t load(const char *vertexShaderSource, const char *fragmentShaderSource);
+
+	/**
+	 * Stores the binary of a program linked from the given shaders.
+	 *
+	 * <p>The program should have been linked with <code>GL_PROGRAM_BINARY_RETRIEVABLE_HINT</code> set.</p>
+	 *
+	 * @param program The name of the linked program.
+	 * @param vertexShaderSource The source of the vertex shader.
+	 * @param fragmentShaderSource The source of the fragment shader.
+	 * @return <code>false</code> if the binary could not be written.
+	 */
+	bool store(uint32_t program, const char *vertexShaderSource, const char *fragmentShaderSource);
+
+	/**
+	 * Gets the number of programs that were loaded from the cache.
+	 *
+	 * @return the number of hits.
+	 */
+	[[nodiscard]] unsigned long getHits() const;
+
+	/**
+	 * Gets the number of programs that were not found in the cache.
+	 *
+	 * @return the number of misses.
+	 */
+	[[nodiscard]] unsigned long getMisses() const;
+};
+
+
+#endif /* CORE_CONCURRENT_FPROGRAMCACHE_HPP_ */
@@ -0,0 +1,161 @@
+/*
+ * FRenderThread.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FRenderThread.hpp"
+#include "FExecutor.hpp"
+
+
+//---------------------------------------------------------------------------//
+//                             Render Thread Class                           //
+//---------------------------------------------------------------------------//
+
+FRenderThread::FRenderThread(const std::string &name, FEventPump *eventPump, const double ticksPerSecond, const SwapSyncMode swapSyncMode)
+		: FThread(name, ticksPerSecond, QUEUE_ENABLED)
+{
+	this->m_windows = std::vector<FWindow *>();
+	this->m_closedWindows = std::vector<FWindow *>();
+	this->m_eventPump = eventPump;
+	this->m_swapSyncMode = swapSyncMode;
+	this->m_frameCount = 0;
+	this->m_windowFrameCount = 0;
+}
+
+FRenderThread::~FRenderThread()
+{
+	for (FWindow *window : this->m_windows)
+		delete window;
+}
+
+void FRenderThread::onStart()
+{
+	std::vector<FWindow *> windows;
+	windows.swap(this->m_windows);
+
+	syncWait(then(schedule(FMainThreadExecutor(this->m_eventPump)), [this, &windows] {
+		for (FWindow *window : windows)
+		{
+			if (window->createWindow())
+			{
+				this->m_eventPump->attach(window, this);
+				this->m_windows.push_back(window);
+			}
+			else
+			{
+				delete window;
+			}
+		}
+	}));
+
+	// only issues the programs of the windows, they are drawn once their programs are ready
+	for (FWindow *window : this->m_windows)
+		window->createResources();
+
+	if (this->m_windows.empty())
+		this->stop();
+}
+
+void FRenderThread::onTick(const unsigned long currentTime, const unsigned long)
+{
+	// the event batches queued before the windows were detached have been handled right before this tick
+	for (FWindow *window : this->m_closedWindows)
+		delete window;
+	this->m_closedWindows.clear();
+
+	std::vector<FWindow *> closedWindows;
+	for (auto iterator = this->m_windows.begin(); iterator != this->m_windows.end();)
+	{
+		if ((*iterator)->isCloseRequested())
+		{
+			closedWindows.push_back(*iterator);
+			iterator = this->m_windows.erase(iterator);
+		}
+		else
+		{
+			++iterator;
+		}
+	}
+
+	if (!closedWindows.empty())
+	{
+		this->destroyWindows(closedWindows);
+		this->m_closedWindows = closedWindows;
+	}
+
+	if (this->m_windows.empty())
+	{
+		this->stop();
+		return;
+	}
+
+	std::vector<FWindow *> damagedWindows;
+	for (FWindow *window : this->m_windows)
+	{
+		window->update(currentTime);
+		if (window->isRedrawRequested())
+			damagedWindows.push_back(window);
+	}
+
+	// windows whose content did not change keep their front buffer, so neither drawing nor swapping is necessary
+	if (damagedWindows.empty())
+		return;
+
+	for (size_t n = 0; n < damagedWindows.size(); n++)
+	{
+		FWindow *window = damagedWindows[n];
+		window->render();
+
+		// every swap with an interval waits for the next screen update, so only the last one of the tick does
+		bool last = n + 1 == damagedWindows.size();
+		window->swap(this->m_swapSyncMode == SWAP_SYNC_ALL || (this->m_swapSyncMode == SWAP_SYNC_LAST && last) ? 1 : 0);
+	}
+
+	this->m_frameCount++;
+	this->m_windowFrameCount += damagedWindows.size();
+}
+
+void FRenderThread::onStop()
+{
+	// no task is executed anymore, so the windows can be deleted right away
+	this->destroyWindows(this->m_windows);
+	for (FWindow *window : this->m_windows)
+		delete window;
+	this->m_windows.clear();
+
+	for (FWindow *window : this->m_closedWindows)
+		delete window;
+	this->m_closedWindows.clear();
+}
+
+void FRenderThread::destroyWindows(const std::vector<FWindow *> &windows)
+{
+	for (FWindow *window : windows)
+		window->destroyResources();
+
+	syncWait(then(schedule(FMainThreadExecutor(this->m_eventPump)), [this, &windows] {
+		for (FWindow *window : windows)
+		{
+			this->m_eventPump->detach(window);
+			window->destroyWindow();
+		}
+	}));
+}
+
+void FRenderThread::addWindow(FWindow *window)
+{
+	if (!this->hasStarted())
+		this->m_windows.push_back(window);
+}
+
+unsigned long FRenderThread::getFrameCount() const
+{
+	return this->m_frameCount;
+}
+
+unsigned long FRenderThread::getWindowFrameCount() const
+{
+	return this->m_windowFrameCount;
+}
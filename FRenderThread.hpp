@@ -0,0 +1,133 @@
+/*
+ * FRenderThread.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FRENDERTHREAD_HPP_
+#define CORE_CONCURRENT_FRENDERTHREAD_HPP_
+
+#include <string>
+#include <vector>
+
+#include "FThread.hpp"
+#include "FEventPump.hpp"
+
+/**
+ * Enum defining which buffer swaps of a tick wait for the screen update.
+ */
+enum SwapSyncMode
+{
+	/**
+	 * Only the last swap of a tick waits, so the windows do not stall each other.
+	 */
+	SWAP_SYNC_LAST,
+	/**
+	 * Every swap waits, like one FThread per window.
+	 */
+	SWAP_SYNC_ALL,
+	/**
+	 * No swap waits.
+	 */
+	SWAP_SYNC_NONE
+};
+
+/**
+ * FThread rendering any number of {@link FWindow}s every tick.
+ *
+ * <p>The windows are created in {@link #onStart()} and rendered one after another, each in its own GL context. A window
+ * is only drawn and swapped in a tick if it requested a redraw, e.g. after being resized, so an idle window costs
+ * neither CPU nor GPU time and no window is drawn more than once per tick.</p>
+ *
+ * <p>GLFW windows are created and destroyed on the main thread through the event pump, which also delivers their events
+ * to this FThread, so the main thread has to run the pump while the FThread is alive. A window is destroyed once the
+ * user requested to close it and the FThread stops itself after the last window has been closed.</p>
+ */
+class FRenderThread : public FThread
+{
+private:
+
+	/**
+	 * A list with pointers to the windows, owned by the FThread.
+	 */
+	std::vector<FWindow *> m_windows;
+	/**
+	 * A list with pointers to the windows closed during the last tick, deleted once their queued events are handled.
+	 */
+	std::vector<FWindow *> m_closedWindows;
+	/**
+	 * A pointer to the event pump of the main thread.
+	 */
+	FEventPump *m_eventPump;
+	/**
+	 * The {@link SwapSyncMode} of the FThread.
+	 */
+	SwapSyncMode m_swapSyncMode;
+	/**
+	 * The number of ticks in which the FThread has drawn at least one window.
+	 */
+	std::atomic_ulong m_frameCount;
+	/**
+	 * The number of frames drawn summed over all windows.
+	 */
+	std::atomic_ulong m_windowFrameCount;
+
+	/**
+	 * Destroys the given windows.
+	 *
+	 * @param windows A reference to the windows.
+	 */
+	void destroyWindows(const std::vector<FWindow *> &windows);
+
+protected:
+
+	void onStart() override;
+
+	void onTick(unsigned long currentTime, unsigned long currentTick) override;
+
+	void onStop() override;
+
+public:
+
+	/**
+	 * Constructs a new FRenderThread.
+	 *
+	 * @param name A reference to the name of the FThread.
+	 * @param eventPump A pointer to the event pump of the main thread.
+	 * @param ticksPerSecond The ticks per second the FThread tries to achieve.
+	 * @param swapSyncMode The {@link SwapSyncMode} of the FThread.
+	 */
+	FRenderThread(const std::string &name, FEventPump *eventPump, double ticksPerSecond = 60.0, SwapSyncMode swapSyncMode = SWAP_SYNC_LAST);
+
+	/**
+	 * Destroys the FRenderThread and the windows that have not been closed.
+	 */
+	~FRenderThread() override;
+
+	/**
+	 * Adds a window that is rendered by this FThread.
+	 *
+	 * <p>Has no effect once the FThread has been started, otherwise the FThread takes the ownership of the window.</p>
+	 *
+	 * @param window A pointer to the window.
+	 */
+	void addWindow(FWindow *window);
+
+	/**
+	 * Gets the number of frames the FThread has rendered, one frame covers every window that requested a redraw.
+	 *
+	 * @return the number of frames.
+	 */
+	[[nodiscard]] unsigned long getFrameCount() const;
+
+	/**
+	 * Gets the number of frames drawn summed over all windows.
+	 *
+	 * @return the number of window frames.
+	 */
+	[[nodiscard]] unsigned long getWindowFrameCount() const;
+};
+
+
+#endif /* CORE_CONCURRENT_FRENDERTHREAD_HPP_ */
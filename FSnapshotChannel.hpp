@@ -0,0 +1,166 @@
+/*
+ * FSnapshotChannel.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FSNAPSHOTCHANNEL_HPP_
+#define CORE_CONCURRENT_FSNAPSHOTCHANNEL_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+#include "FThread.hpp"
+
+/**
+ * Triple buffered channel handing the latest snapshot of a state from one writer to one reader.
+ *
+ * <p>The writer fills the buffer returned by {@link #getWriteBuffer()} in place and calls {@link #publish()}.
+ * The reader calls {@link #read()} and always gets the latest complete snapshot. Neither side blocks, copies or
+ * allocates, publishing and reading are a single atomic exchange. Snapshots the reader did not pick up in time are
+ * overwritten, so the writer never waits for the reader.</p>
+ *
+ * <p>The buffers are reused, so the writer has to overwrite every field of the write buffer before publishing it.</p>
+ *
+ * @tparam T The type of the snapshot.
+ */
+template<typename T>
+class FSnapshotChannel
+{
+private:
+
+	/**
+	 * Mask of the buffer index in {@link #m_shared}.
+	 */
+	static constexpr uint8_t INDEX_MASK = 0x3;
+	/**
+	 * Bit in {@link #m_shared} which is set when the shared buffer contains a snapshot the reader has not seen yet.
+	 */
+	static constexpr uint8_t NEW_SNAPSHOT = 0x4;
+
+	/**
+	 * The three buffers of the channel.
+	 */
+	T m_buffers[3];
+	/**
+	 * The sequence numbers of the snapshots in the three buffers.
+	 */
+	unsigned long m_sequences[3];
+	/**
+	 * The index of the buffer that is neither written nor read right now and the {@link #NEW_SNAPSHOT} bit.
+	 */
+	alignas(CACHE_LINE_SIZE) std::atomic<uint8_t> m_shared;
+	/**
+	 * The index of the buffer the writer is filling. Only accessed by the writer.
+	 */
+	alignas(CACHE_LINE_SIZE) uint8_t m_writeIndex;
+	/**
+	 * The sequence number of the next snapshot that will be published. Only accessed by the writer.
+	 */
+	unsigned long m_nextSequence;
+	/**
+	 * The index of the buffer the reader is reading. Only accessed by the reader.
+	 */
+	alignas(CACHE_LINE_SIZE) uint8_t m_readIndex;
+
+public:
+
+	/**
+	 * Constructs a new FSnapshotChannel.
+	 *
+	 * @param initial A reference to the snapshot the reader sees until the first snapshot is published.
+	 */
+	explicit FSnapshotChannel(const T &initial = T()) : m_buffers{initial, initial, initial}, m_sequences{0, 0, 0}
+	{
+		this->m_writeIndex = 0;
+		this->m_shared = 1;
+		this->m_readIndex = 2;
+		this->m_nextSequence = 1;
+	}
+
+	FSnapshotChannel(const FSnapshotChannel &) = delete;
+
+	FSnapshotChannel &operator=(const FSnapshotChannel &) = delete;
+
+	/**
+	 * Gets the buffer the writer fills the next snapshot into.
+	 *
+	 * <p>Must only be called by the writer. The buffer contains an old snapshot.</p>
+	 *
+	 * @return a reference to the write buffer.
+	 */
+	T &getWriteBuffer()
+	{
+		return this->m_buffers[this->m_writeIndex];
+	}
+
+	/**
+	 * Publishes the write buffer as the latest snapshot.
+	 *
+	 * <p>Must only be called by the writer. Afterwards {@link #getWriteBuffer()} returns a different buffer.</p>
+	 */
+	void publish()
+	{
+		this->m_sequences[this->m_writeIndex] = this->m_nextSequence++;
+		uint8_t previous = this->m_shared.exchange(this->m_writeIndex | NEW_SNAPSHOT, std::memory_order_acq_rel);
+		this->m_writeIndex = previous & INDEX_MASK;
+	}
+
+	/**
+	 * Copies the given snapshot into the write buffer and publishes it.
+	 *
+	 * <p>Must only be called by the writer.</p>
+	 *
+	 * @param snapshot A reference to the snapshot that will be published.
+	 */
+	void publish(const T &snapshot)
+	{
+		this->getWriteBuffer() = snapshot;
+		this->publish();
+	}
+
+	/**
+	 * Gets the latest complete snapshot.
+	 *
+	 * <p>Must only be called by the reader. The returned reference stays valid until the next call of this method.</p>
+	 *
+	 * @return a const reference to the latest snapshot.
+	 */
+	const T &read()
+	{
+		if (this->m_shared.load(std::memory_order_relaxed) & NEW_SNAPSHOT)
+		{
+			uint8_t previous = this->m_shared.exchange(this->m_readIndex, std::memory_order_acq_rel);
+			this->m_readIndex = previous & INDEX_MASK;
+		}
+
+		return this->m_buffers[this->m_readIndex];
+	}
+
+	/**
+	 * Gets whether a snapshot was published since the last call of {@link #read()}.
+	 *
+	 * @return <code>true</code> when {@link #read()} will return a newer snapshot.
+	 */
+	[[nodiscard]] bool hasNewSnapshot() const
+	{
+		return this->m_shared.load(std::memory_order_relaxed) & NEW_SNAPSHOT;
+	}
+
+	/**
+	 * Gets the sequence number of the snapshot returned by the last call of {@link #read()}.
+	 *
+	 * <p>Must only be called by the reader. Published snapshots are numbered starting at one, the initial snapshot has
+	 * the sequence number zero.</p>
+	 *
+	 * @return the sequence number of the current snapshot of the reader.
+	 */
+	[[nodiscard]] unsigned long getSequence() const
+	{
+		return this->m_sequences[this->m_readIndex];
+	}
+};
+
+
+#endif /* CORE_CONCURRENT_FSNAPSHOTCHANNEL_HPP_ */
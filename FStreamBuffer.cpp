@@ -0,0 +1,188 @@
+/*
+ * FStreamBuffer.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FStreamBuffer.hpp"
+#include "FLogger.hpp"
+
+
+/**
+ * The alignment of the regions, large enough for any uniform buffer offset alignment.
+ */
+static constexpr size_t REGION_ALIGNMENT = 256;
+/**
+ * The time in nanoseconds a stalled frame waits for its fence before checking again.
+ */
+static constexpr GLuint64 FENCE_WAIT_TIME = 1000000;
+
+
+//---------------------------------------------------------------------------//
+//                             Stream Buffer Class                           //
+//---------------------------------------------------------------------------//
+
+FStreamBuffer::FStreamBuffer(const GLenum target, const size_t regionSize, const unsigned int regionCount)
+{
+	this->m_target = target;
+	this->m_regionSize = (regionSize + REGION_ALIGNMENT - 1) / REGION_ALIGNMENT * REGION_ALIGNMENT;
+	this->m_buffer = 0;
+	this->m_persistent = false;
+	this->m_mapping = nullptr;
+	this->m_fences = std::vector<GLsync>(regionCount > 0 ? regionCount : 1, nullptr);
+	this->m_region = this->m_fences.size() - 1;
+	this->m_used = 0;
+	this->m_inFrame = false;
+	this->m_stalls = 0;
+}
+
+FStreamBuffer::~FStreamBuffer()
+{
+	if (this->m_buffer != 0)
+		FLogger::warning("FStreamBuffer", "destroyed without deleting buffer {}", this->m_buffer);
+}
+
+bool FStreamBuffer::create()
+{
+	auto size = static_cast<GLsizeiptr>(this->m_regionSize * this->m_fences.size());
+
+	glGenBuffers(1, &this->m_buffer);
+	glBindBuffer(this->m_target, this->m_buffer);
+	if (GLAD_GL_VERSION_4_4)
+	{
+		// a coherent mapping makes the writes visible to the GPU without flushing them
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(this->m_target, size, nullptr, flags);
+		this->m_mapping = static_cast<char *>(glMapBufferRange(this->m_target, 0, size, flags));
+		this->m_persistent = this->m_mapping != nullptr;
+		if (!this->m_persistent)
+		{
+			glBindBuffer(this->m_target, 0);
+			glDeleteBuffers(1, &this->m_buffer);
+			this->m_buffer = 0;
+			FLogger::error("FStreamBuffer", "could not map {} bytes persistently!", static_cast<long long>(size));
+			return false;
+		}
+	}
+	else
+	{
+		glBufferData(this->m_target, size, nullptr, GL_STREAM_DRAW);
+	}
+	glBindBuffer(this->m_target, 0);
+	return true;
+}
+
+void FStreamBuffer::destroy()
+{
+	if (this->m_buffer == 0)
+		return;
+
+	for (GLsync &fence : this->m_fences)
+	{
+		if (fence != nullptr)
+			glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	if (this->m_mapping != nullptr)
+	{
+		glBindBuffer(this->m_target, this->m_buffer);
+		glUnmapBuffer(this->m_target);
+		glBindBuffer(this->m_target, 0);
+		this->m_mapping = nullptr;
+	}
+
+	glDeleteBuffers(1, &this->m_buffer);
+	this->m_buffer = 0;
+	this->m_persistent = false;
+	this->m_inFrame = false;
+}
+
+bool FStreamBuffer::beginFrame()
+{
+	if (this->m_buffer == 0)
+		return false;
+	if (this->m_inFrame)
+		this->endFrame();
+
+	this->m_region = (this->m_region + 1) % this->m_fences.size();
+	GLsync &fence = this->m_fences[this->m_region];
+	if (fence != nullptr)
+	{
+		GLenum status = glClientWaitSync(fence, 0, 0);
+		if (status == GL_TIMEOUT_EXPIRED)
+		{
+			// the GPU is as many frames behind as there are regions
+			this->m_stalls++;
+			do
+			{
+				status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_WAIT_TIME);
+			} while (status == GL_TIMEOUT_EXPIRED);
+		}
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	if (!this->m_persistent)
+	{
+		// the fence already guarantees that the GPU is done with the region
+		glBindBuffer(this->m_target, this->m_buffer);
+		this->m_mapping = static_cast<char *>(glMapBufferRange(this->m_target, static_cast<GLintptr>(this->m_region * this->m_regionSize),
+				static_cast<GLsizeiptr>(this->m_regionSize), GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+		glBindBuffer(this->m_target, 0);
+		if (this->m_mapping == nullptr)
+			return false;
+	}
+
+	this->m_used = 0;
+	this->m_inFrame = true;
+	return true;
+}
+
+void *FStreamBuffer::allocate(const size_t size, const size_t alignment, size_t &offset)
+{
+	size_t begin = alignment > 1 ? (this->m_used + alignment - 1) / alignment * alignment : this->m_used;
+	if (!this->m_inFrame || this->m_mapping == nullptr || begin + size > this->m_regionSize)
+		return nullptr;
+
+	this->m_used = begin + size;
+	offset = this->m_region * this->m_regionSize + begin;
+	return this->m_persistent ? this->m_mapping + offset : this->m_mapping + begin;
+}
+
+void FStreamBuffer::flush()
+{
+	if (this->m_persistent || this->m_mapping == nullptr)
+		return;
+
+	glBindBuffer(this->m_target, this->m_buffer);
+	glUnmapBuffer(this->m_target);
+	glBindBuffer(this->m_target, 0);
+	this->m_mapping = nullptr;
+}
+
+void FStreamBuffer::endFrame()
+{
+	if (!this->m_inFrame)
+		return;
+
+	this->flush();
+	this->m_fences[this->m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	this->m_inFrame = false;
+}
+
+uint32_t FStreamBuffer::getBuffer() const
+{
+	return this->m_buffer;
+}
+
+bool FStreamBuffer::isPersistent() const
+{
+	return this->m_persistent;
+}
+
+unsigned long FStreamBuffer::getStalls() const
+{
+	return this->m_stalls;
+}
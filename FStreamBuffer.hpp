@@ -0,0 +1,158 @@
+/*
+ * FStreamBuffer.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FSTREAMBUFFER_HPP_
+#define CORE_CONCURRENT_FSTREAMBUFFER_HPP_
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "glad/glad.h"
+
+/**
+ * Class streaming per-frame vertex or uniform data to the GPU through a ring of buffer regions.
+ *
+ * <p>The buffer is allocated once with <code>glBufferStorage</code> and stays mapped persistently and coherently, so data
+ * is written by the CPU straight into memory the GPU reads from, without <code>glBufferData</code> reallocating or the
+ * driver copying it. The buffer is split into regions, by default three. Every frame writes into the next region, while the
+ * GPU may still read the regions of the previous frames. A fence placed at the end of a frame guards its region, so a
+ * region is only written again once the GPU is done with it, which only waits if the GPU is more frames behind than there
+ * are regions.</p>
+ *
+ * <p>Without OpenGL 4.4 each frame maps its region unsynchronized instead and unmaps it in {@link #flush()}, which still
+ * avoids reallocations but not the driver copy. Both leave the target unbound, so the buffer must be bound again before
+ * the draw calls of the frame set up their attributes.</p>
+ *
+ * <p>A frame is written in the order {@link #beginFrame()}, {@link #allocate()}, {@link #flush()}, draw calls and
+ * {@link #endFrame()}. The stream buffer belongs to the context that created it and must only be used by the FThread
+ * rendering with that context.</p>
+ */
+class FStreamBuffer
+{
+private:
+
+	/**
+	 * The target the buffer is bound to when it is created.
+	 */
+	GLenum m_target;
+	/**
+	 * The size of a region in bytes.
+	 */
+	size_t m_regionSize;
+	/**
+	 * The name of the buffer, 0 while it is not created.
+	 */
+	uint32_t m_buffer;
+	/**
+	 * Whether the buffer is mapped persistently.
+	 */
+	bool m_persistent;
+	/**
+	 * The mapped memory of the whole buffer while it is mapped persistently, of the current region otherwise.
+	 */
+	char *m_mapping;
+	/**
+	 * The fences guarding the regions, <code>nullptr</code> if the GPU does not use a region.
+	 */
+	std::vector<GLsync> m_fences;
+	/**
+	 * The region of the current frame.
+	 */
+	size_t m_region;
+	/**
+	 * The number of bytes allocated in the current region.
+	 */
+	size_t m_used;
+	/**
+	 * Whether a frame has been begun and not ended yet.
+	 */
+	bool m_inFrame;
+	/**
+	 * The number of frames that had to wait for the GPU to release their region.
+	 */
+	unsigned long m_stalls;
+
+public:
+
+	/**
+	 * Constructs a new FStreamBuffer, the buffer is created by {@link #create()}.
+	 *
+	 * @param target The target of the buffer, e.g. <code>GL_ARRAY_BUFFER</code> or <code>GL_UNIFORM_BUFFER</code>.
+	 * @param regionSize The number of bytes a single frame can allocate.
+	 * @param regionCount The number of frames the GPU may be behind before a frame waits.
+	 */
+	FStreamBuffer(GLenum target, size_t regionSize, unsigned int regionCount = 3);
+
+	/**
+	 * Destroys the FStreamBuffer, {@link #destroy()} must have been called in its context before.
+	 */
+	~FStreamBuffer();
+
+	/**
+	 * Creates and maps the buffer in the current context.
+	 *
+	 * @return <code>false</code> if the buffer could not be mapped.
+	 */
+	bool create();
+
+	/**
+	 * Unmaps and deletes the buffer in the current context.
+	 */
+	void destroy();
+
+	/**
+	 * Begins a frame in the next region, waiting for the GPU if it still reads the region.
+	 *
+	 * @return <code>false</code> if the region could not be mapped.
+	 */
+	bool beginFrame();
+
+	/**
+	 * Allocates memory for the current frame.
+	 *
+	 * @param size The number of bytes.
+	 * @param alignment The alignment of the offset in bytes, e.g. <code>GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT</code>.
+	 * @param offset A reference to the offset of the memory in the buffer, set by this method.
+	 * @return a pointer to the memory or <code>nullptr</code> if the region has no space left.
+	 */
+	void *allocate(size_t size, size_t alignment, size_t &offset);
+
+	/**
+	 * Makes the data written during the current frame available to the following draw calls.
+	 */
+	void flush();
+
+	/**
+	 * Ends the current frame, must be called after its last draw call reading the buffer.
+	 */
+	void endFrame();
+
+	/**
+	 * Gets the name of the buffer.
+	 *
+	 * @return the name of the buffer, 0 while it is not created.
+	 */
+	[[nodiscard]] uint32_t getBuffer() const;
+
+	/**
+	 * Gets whether the buffer is mapped persistently.
+	 *
+	 * @return <code>true</code> if the data is written without driver copies.
+	 */
+	[[nodiscard]] bool isPersistent() const;
+
+	/**
+	 * Gets the number of frames that had to wait for the GPU.
+	 *
+	 * @return the number of stalls.
+	 */
+	[[nodiscard]] unsigned long getStalls() const;
+};
+
+
+#endif /* CORE_CONCURRENT_FSTREAMBUFFER_HPP_ */
@@ -6,7 +6,9 @@
  */
 
 #include "FThread.hpp"
-#include <iostream>
+#include "FChannel.hpp"
+#include "FLogger.hpp"
+#include <algorithm>
 
 
 //---------------------------------------------------------------------------//
@@ -14,7 +16,9 @@
 //---------------------------------------------------------------------------//
 
 std::vector<FThread *> *FThread::INSTANCES = new std::vector<FThread *>();
-std::mutex *FThread::INSTANCES_MUTEX = new std::mutex();
+FMutex *FThread::INSTANCES_MUTEX = new FMutex("FThread::INSTANCES");
+std::condition_variable_any *FThread::INSTANCES_CONDITION = new std::condition_variable_any();
+thread_local FThread *FThread::CURRENT_THREAD = nullptr;
 
 const std::chrono::duration<long, std::micro> MIN_OVERHEAD = std::chrono::microseconds(-2000);
 const std::chrono::duration<long, std::micro> MAX_OVERHEAD = std::chrono::microseconds(2000);
@@ -22,10 +26,18 @@ const std::chrono::duration<long, std::micro> MAX_OVERHEAD = std::chrono::micros
 FThread::FThread(const std::string &name, const double ticksPerSecond, const TaskQueueMode &taskQueueMode, const unsigned int taskQueueThreshold, const bool selfDestruct)
 {
 	this->m_name = name;
+	this->m_taskQueueMutex.setName(name + "::m_taskQueueMutex");
 	this->m_thread = nullptr;
-	this->m_waitingList = std::vector<FThread *>();
+	this->m_dependencies = std::vector<FThread *>();
+	this->m_dependents = std::vector<FThread *>();
+	this->m_pendingDependencies = 0;
+	this->m_initialized = false;
+	this->m_startWaitTime = 0;
+	this->m_startDuration = 0;
+	this->m_channels = std::vector<FChannelBase *>();
 	this->m_frontTaskQueue = new std::queue<std::function<void()>>();
 	this->m_backTaskQueue = new std::queue<std::function<void()>>();
+	this->m_localTaskQueue = std::queue<std::function<void()>>();
 
 	if (ticksPerSecond <= 0.0)
 	{
@@ -47,6 +59,13 @@ FThread::FThread(const std::string &name, const double ticksPerSecond, const Tas
 	this->m_running = false;
 	this->m_stopping = false;
 	this->m_selfDestructing = selfDestruct;
+	this->m_shutdownPolicy = SHUTDOWN_DISCARD_QUEUE;
+	this->m_clock = FClock::getRealClock();
+	this->m_group = nullptr;
+	this->m_phaseOffset = std::chrono::microseconds(0);
+	this->m_groupStage = 0;
+	this->m_expectedByGroup = false;
+	this->m_groupTick = 0;
 	this->m_tickTime = 0;
 
 	INSTANCES_MUTEX->lock();
@@ -60,7 +79,11 @@ FThread::~FThread()
 	delete this->m_backTaskQueue;
 	delete this->m_thread;
 
+	this->m_clock->detach(&this->m_sleeper);
+
 	INSTANCES_MUTEX->lock();
+	this->detachFromStartGraph();
+
 	auto it = INSTANCES->begin();
 	while (it != INSTANCES->end())
 	{
@@ -77,53 +100,111 @@ FThread::~FThread()
 
 std::thread *FThread::start(const unsigned int waitForSize, FThread **waitFor)
 {
-	this->m_started = true;
-	this->m_stopping = false;
-	if (waitForSize > 0)
+	INSTANCES_MUTEX->lock();
+	for (unsigned int n = 0; n < waitForSize; n++)
 	{
-		this->m_waitingListMutex.lock();
-		for (unsigned int n = 0; n < waitForSize; n++)
+		if (waitFor[n] == this || waitFor[n]->dependsOn(this))
 		{
-			if (!waitFor[n]->m_running)
-			{
-				this->m_waitingList.push_back(waitFor[n]);
-			}
+			INSTANCES_MUTEX->unlock();
+			FLogger::error(this->m_name, "waiting for {} would result in a dependency cycle!", waitFor[n]->m_name);
+			return nullptr;
 		}
-		this->m_waitingListMutex.unlock();
 	}
 
+	this->m_started = true;
+	this->m_stopping = false;
+	this->m_pendingDependencies = 0;
+	for (unsigned int n = 0; n < waitForSize; n++)
+	{
+		FThread *dependency = waitFor[n];
+		if (std::find(this->m_dependencies.begin(), this->m_dependencies.end(), dependency) != this->m_dependencies.end())
+			continue;
+
+		this->m_dependencies.push_back(dependency);
+		dependency->m_dependents.push_back(this);
+		if (!dependency->m_initialized)
+			this->m_pendingDependencies++;
+	}
+	INSTANCES_MUTEX->unlock();
+
+	// a member restarted after it left its group is waited for again
+	if (this->m_group != nullptr)
+		this->m_group->expect(this);
+	this->m_clock->attach(&this->m_sleeper);
+
 	return new std::thread(&FThread::preStart, this);
 }
 
 void FThread::preStart()
 {
-	this->m_waitingListMutex.lock();
-	bool isEmpty = this->m_waitingList.empty();
-	this->m_waitingListMutex.unlock();
-
-	while (!isEmpty)
+	CURRENT_THREAD = this;
+	FAllocationTracker::attach(&this->m_allocationStats);
+	std::chrono::time_point<std::chrono::high_resolution_clock> waitStart = std::chrono::high_resolution_clock::now();
+	std::unique_lock<FMutex> lock(*INSTANCES_MUTEX);
+	this->m_startCondition.wait(lock, [this] { return this->m_pendingDependencies == 0 || this->m_stopping; });
+	lock.unlock();
+
+	// stopped before all dependencies were started
+	if (this->m_stopping)
 	{
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-
-		this->m_waitingListMutex.lock();
-		isEmpty = this->m_waitingList.empty();
-		this->m_waitingListMutex.unlock();
+		FAllocationTracker::attach(nullptr);
+		if (this->m_group != nullptr)
+			this->m_group->leave(this);
+		this->m_clock->detach(&this->m_sleeper);
+
+		lock.lock();
+		this->detachFromStartGraph();
+		this->m_started = false;
+		this->m_stopping = false;
+		INSTANCES_CONDITION->notify_all();
+		lock.unlock();
+
+		if (this->m_selfDestructing)
+			delete this;
+		return;
 	}
 
+	std::chrono::time_point<std::chrono::high_resolution_clock> startBegin = std::chrono::high_resolution_clock::now();
+	this->m_startWaitTime = std::chrono::duration_cast<std::chrono::microseconds>(startBegin - waitStart).count();
+
 	this->onStart();
 
-	INSTANCES_MUTEX->lock();
-	for (FThread *thread : *INSTANCES)
+	this->m_startDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - startBegin).count();
+
+	lock.lock();
+	this->m_initialized = true;
+	for (FThread *dependent : this->m_dependents)
 	{
-		thread->removeFromWaitingList(this);
+		if (--dependent->m_pendingDependencies == 0)
+			dependent->m_startCondition.notify_one();
 	}
-	INSTANCES_MUTEX->unlock();
+	lock.unlock();
 
 	this->run();
+
+	if (this->m_shutdownPolicy == SHUTDOWN_DRAIN_QUEUE && this->m_taskQueueMode != QUEUE_DISABLED)
+	{
+		this->processTaskQueue();
+	}
+	else
+	{
+		this->m_taskQueueMutex.lock();
+		std::queue<std::function<void()>>().swap(*this->m_backTaskQueue);
+		this->m_taskQueueMutex.unlock();
+		std::queue<std::function<void()>>().swap(this->m_localTaskQueue);
+	}
+
 	this->onStop();
+	FAllocationTracker::attach(nullptr);
+	this->m_clock->detach(&this->m_sleeper);
 
+	lock.lock();
+	this->detachFromStartGraph();
 	this->m_started = false;
 	this->m_stopping = false;
+	INSTANCES_CONDITION->notify_all();
+	lock.unlock();
+
 	if (this->m_selfDestructing)
 	{
 		delete this;
@@ -132,128 +213,345 @@ void FThread::preStart()
 
 void FThread::run()
 {
-	std::chrono::time_point<std::chrono::high_resolution_clock> currentTick = std::chrono::high_resolution_clock::now();
-	std::chrono::time_point<std::chrono::high_resolution_clock> lastTick = currentTick - this->m_sleepTime;
-	std::chrono::time_point<std::chrono::high_resolution_clock> sleepUntil;
+	std::chrono::microseconds currentTick = this->m_clock->now();
+	std::chrono::microseconds lastTick = currentTick - this->m_sleepTime.load();
+	std::chrono::microseconds sleepUntil;
+	std::chrono::microseconds sleepTime;
 	std::chrono::duration<long, std::micro> overhead = std::chrono::microseconds(0);
 	std::chrono::duration<long, std::micro> duration = std::chrono::microseconds(0);
 	this->m_running = true;
+	// stop() might have been called while the FThread was starting
+	if (this->m_stopping)
+		this->m_running = false;
 
 	if (this->m_taskQueueMode == QUEUE_ONLY)
 	{
 		bool isEmpty;
+		size_t drained;
 		while (this->m_running)
 		{
+			FAllocationTracker::setPhase(ALLOCATION_PHASE_CHANNELS);
+			drained = this->drainChannels();
+			FAllocationTracker::setPhase(ALLOCATION_PHASE_OTHER);
+
 			this->m_taskQueueMutex.lock();
 			isEmpty = this->m_backTaskQueue->empty();
 			this->m_taskQueueMutex.unlock();
+			isEmpty = isEmpty && this->m_localTaskQueue.empty();
 
 			if (isEmpty)
 			{
-				std::this_thread::sleep_for(this->m_sleepTime);
+				if (drained > 0)
+					continue;
+
+				if (this->m_noSleepThread)
+					this->m_clock->sleepUntil(&this->m_sleeper, FClock::FOREVER);
+				else
+					this->m_clock->sleepUntil(&this->m_sleeper, this->m_clock->now() + this->m_sleepTime.load());
 			}
 			else
 			{
+				FAllocationTracker::setPhase(ALLOCATION_PHASE_TASKS);
 				this->processTaskQueue();
+				FAllocationTracker::setPhase(ALLOCATION_PHASE_OTHER);
 			}
 		}
 	}
+	else if (this->m_group != nullptr)
+	{
+		unsigned long groupTick = this->m_group->enter(this);
+		while (this->m_running)
+		{
+			if (this->m_group->isSynchronized() && !this->m_group->arriveAndWait(this, groupTick))
+				break;
+
+			this->sleepUntilTick(this->m_group->getTickTime(groupTick) + this->m_phaseOffset);
+			if (!this->m_running)
+				break;
+
+			currentTick = this->m_clock->now();
+			this->m_tickTime = currentTick.count();
+			this->m_groupTick = groupTick;
+
+			this->tick();
+
+			// an unsynchronized member that overran its tick skips the missed ticks to stay in phase
+			groupTick = std::max(groupTick + 1, this->m_group->getTickAt(this->m_clock->now(), this->m_phaseOffset));
+		}
+		this->m_group->leave(this);
+	}
 	else
 	{
 		while (this->m_running)
 		{
 			if (this->m_noSleepThread)
 			{
-				currentTick = std::chrono::high_resolution_clock::now();
-				duration = std::chrono::duration_cast<std::chrono::microseconds>(currentTick - lastTick);
+				currentTick = this->m_clock->now();
+				duration = currentTick - lastTick;
 				lastTick = currentTick;
+				this->m_tickTime = currentTick.count();
 
-				if (this->m_taskQueueMode == QUEUE_ENABLED)
-					this->processTaskQueue();
-
-				this->m_tickTime = std::chrono::duration_cast<std::chrono::microseconds>(currentTick.time_since_epoch()).count();
-
-				this->onTick(this->m_tickTime, this->m_tickCount++);
+				this->tick();
 			}
 			else
 			{
-				currentTick = std::chrono::high_resolution_clock::now();
+				currentTick = this->m_clock->now();
 
-				duration = std::chrono::duration_cast<std::chrono::microseconds>(currentTick - lastTick);
+				duration = currentTick - lastTick;
 
-				this->m_sleepTimeMutex.lock();
-				overhead += duration - this->m_sleepTime;
+				sleepTime = this->m_sleepTime.load(std::memory_order_relaxed);
+				overhead += duration - sleepTime;
 
 				if (overhead < MIN_OVERHEAD)
 					overhead = MIN_OVERHEAD;
 				else if (overhead > MAX_OVERHEAD)
 					overhead = MAX_OVERHEAD;
 
-				sleepUntil = currentTick + this->m_sleepTime - overhead;
-				this->m_sleepTimeMutex.unlock();
+				sleepUntil = currentTick + sleepTime - overhead;
 
 				lastTick = currentTick;
-				this->m_tickTime = std::chrono::duration_cast<std::chrono::microseconds>(currentTick.time_since_epoch()).count();
+				this->m_tickTime = currentTick.count();
 
-				if (this->m_taskQueueMode == QUEUE_ENABLED)
-					this->processTaskQueue();
+				this->tick();
 
-				this->onTick(this->m_tickTime, this->m_tickCount++);
-
-				std::this_thread::sleep_until(sleepUntil);
+				this->sleepUntilTick(sleepUntil);
 			}
 		}
 	}
 }
 
-void FThread::stop()
+void FThread::tick()
+{
+	if (this->m_taskQueueMode == QUEUE_ENABLED)
+	{
+		FAllocationTracker::setPhase(ALLOCATION_PHASE_TASKS);
+		this->processTaskQueue();
+	}
+
+	FAllocationTracker::setPhase(ALLOCATION_PHASE_CHANNELS);
+	this->drainChannels();
+
+	FAllocationTracker::setPhase(ALLOCATION_PHASE_TICK);
+	unsigned long tickCount = this->m_tickCount++;
+	this->onTick(this->m_tickTime, tickCount);
+
+	FAllocationTracker::setPhase(ALLOCATION_PHASE_OTHER);
+	FAllocationTracker::endTick(this->m_name, tickCount);
+}
+
+void FThread::stop(const ShutdownPolicy policy)
+{
+	INSTANCES_MUTEX->lock();
+	this->interrupt(policy);
+	INSTANCES_MUTEX->unlock();
+}
+
+void FThread::interrupt(const ShutdownPolicy policy)
 {
+	this->m_shutdownPolicy = policy;
 	this->m_stopping = true;
 	this->m_running = false;
+	this->m_startCondition.notify_one();
+	this->wake();
+}
+
+void FThread::wake()
+{
+	this->m_clock->wake(&this->m_sleeper);
+}
+
+void FThread::sleepUntilTick(const std::chrono::microseconds &sleepUntil)
+{
+	while (this->m_running && this->m_clock->now() < sleepUntil)
+		this->m_clock->sleepUntil(&this->m_sleeper, sleepUntil);
+}
+
+void FThread::addChannel(FChannelBase *channel)
+{
+	if (!this->m_started)
+		this->m_channels.push_back(channel);
+}
+
+size_t FThread::drainChannels()
+{
+	size_t drained = 0;
+	for (FChannelBase *channel : this->m_channels)
+		drained += channel->drain();
+	return drained;
+}
+
+bool FThread::isAlive(const FThread *thread)
+{
+	return std::find(INSTANCES->begin(), INSTANCES->end(), thread) != INSTANCES->end() && thread->m_started;
+}
+
+bool FThread::stopGroup(const unsigned int size, FThread **threads, const std::chrono::milliseconds &timeout, const ShutdownPolicy policy)
+{
+	std::chrono::time_point<std::chrono::high_resolution_clock> deadline = std::chrono::high_resolution_clock::now() + timeout;
+	std::vector<FThread *> remaining(threads, threads + size);
+	std::vector<FThread *> stopping;
+
+	std::unique_lock<FMutex> lock(*INSTANCES_MUTEX);
+	while (true)
+	{
+		remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [] (const FThread *thread) { return !isAlive(thread); }),
+						remaining.end());
+		if (remaining.empty())
+			return true;
+
+		// only stop FThreads whose dependents of this group have finished already
+		stopping.clear();
+		for (FThread *thread : remaining)
+		{
+			bool hasRunningDependent = std::any_of(thread->m_dependents.begin(), thread->m_dependents.end(), [&remaining] (FThread *dependent) {
+				return std::find(remaining.begin(), remaining.end(), dependent) != remaining.end();
+			});
+
+			if (!hasRunningDependent)
+				stopping.push_back(thread);
+		}
+
+		if (stopping.empty())
+			stopping = remaining;
+
+		for (FThread *thread : stopping)
+			thread->interrupt(policy);
+
+		bool finished = INSTANCES_CONDITION->wait_until(lock, deadline, [&stopping] {
+			return std::none_of(stopping.begin(), stopping.end(), isAlive);
+		});
+
+		if (!finished)
+		{
+			for (FThread *thread : remaining)
+			{
+				if (isAlive(thread))
+					thread->interrupt(policy);
+			}
+
+			return false;
+		}
+	}
+}
+
+bool FThread::stopAll(const std::chrono::milliseconds &timeout, const ShutdownPolicy policy)
+{
+	INSTANCES_MUTEX->lock();
+	std::vector<FThread *> threads = *INSTANCES;
+	INSTANCES_MUTEX->unlock();
+
+	return stopGroup(threads.size(), threads.data(), timeout, policy);
 }
 
 void FThread::processTaskQueue()
 {
 	this->m_taskQueueMutex.lock();
-	if (this->m_backTaskQueue->size() > this->m_taskQueueThreshold)
-		std::cout << "[" << this->m_name << "][WARNING]: task queue is bigger than the threshold: " << this->m_backTaskQueue->size() << "/"
-				  << this->m_taskQueueThreshold << "!" << std::endl;
-
+	size_t pendingTasks = this->m_backTaskQueue->size();
 	std::queue<std::function<void()>> *tmp = this->m_frontTaskQueue;
 	this->m_frontTaskQueue = this->m_backTaskQueue;
 	this->m_backTaskQueue = tmp;
 	this->m_taskQueueMutex.unlock();
 
+	if (pendingTasks > this->m_taskQueueThreshold)
+		FLogger::warning(this->m_name, "task queue is bigger than the threshold: {}/{}!", pendingTasks, this->m_taskQueueThreshold);
+
 	while (!this->m_frontTaskQueue->empty())
 	{
 		this->m_frontTaskQueue->front()();
 		this->m_frontTaskQueue->pop();
 	}
+
+	// tasks added by the local tasks themselves are executed in the next pass
+	size_t localTasks = this->m_localTaskQueue.size();
+	for (size_t n = 0; n < localTasks; n++)
+	{
+		std::function<void()> task = std::move(this->m_localTaskQueue.front());
+		this->m_localTaskQueue.pop();
+		task();
+	}
 }
 
-void FThread::addTask(const std::function<void()> &task)
+bool FThread::addTask(const std::function<void()> &task)
 {
-	if (this->m_running && this->m_taskQueueMode != QUEUE_DISABLED)
+	if (this->m_taskQueueMode == QUEUE_DISABLED)
+		return false;
+
+	if (CURRENT_THREAD == this)
 	{
-		this->m_taskQueueMutex.lock();
-		this->m_backTaskQueue->push(task);
-		this->m_taskQueueMutex.unlock();
+		// tasks of onStart() run with the first tick, tasks added once the queue was drained or discarded never run
+		if (!this->m_running && this->m_initialized)
+			return false;
+
+		this->m_localTaskQueue.push(task);
+		return true;
 	}
+
+	if (!this->m_running)
+		return false;
+
+	this->m_taskQueueMutex.lock();
+	this->m_backTaskQueue->push(task);
+	this->m_taskQueueMutex.unlock();
+
+	if (this->m_taskQueueMode == QUEUE_ONLY)
+		this->wake();
+	return true;
 }
 
-void FThread::removeFromWaitingList(FThread *thread)
+bool FThread::dependsOn(const FThread *thread) const
 {
-	this->m_waitingListMutex.lock();
-	auto iterator = this->m_waitingList.begin();
-	while (iterator != this->m_waitingList.end())
+	std::vector<const FThread *> visited;
+	std::vector<const FThread *> pending = {this};
+	while (!pending.empty())
 	{
-		if (*iterator == thread)
+		const FThread *current = pending.back();
+		pending.pop_back();
+
+		for (const FThread *dependency : current->m_dependencies)
 		{
-			this->m_waitingList.erase(iterator);
-			break;
+			if (dependency == thread)
+				return true;
+
+			if (std::find(visited.begin(), visited.end(), dependency) == visited.end())
+			{
+				visited.push_back(dependency);
+				pending.push_back(dependency);
+			}
 		}
 	}
-	this->m_waitingListMutex.unlock();
+
+	return false;
+}
+
+void FThread::detachFromStartGraph()
+{
+	for (FThread *dependent : this->m_dependents)
+	{
+		// a dependency that never finished its onStart() method must not block its dependents forever
+		if (!this->m_initialized && --dependent->m_pendingDependencies == 0)
+			dependent->m_startCondition.notify_one();
+	}
+
+	for (FThread *dependency : this->m_dependencies)
+	{
+		auto &dependents = dependency->m_dependents;
+		dependents.erase(std::remove(dependents.begin(), dependents.end(), this), dependents.end());
+	}
+
+	for (FThread *dependent : this->m_dependents)
+	{
+		auto &dependencies = dependent->m_dependencies;
+		dependencies.erase(std::remove(dependencies.begin(), dependencies.end(), this), dependencies.end());
+	}
+
+	this->m_dependencies.clear();
+	this->m_dependents.clear();
+	this->m_initialized = false;
+}
+
+FThread *FThread::getCurrentThread()
+{
+	return CURRENT_THREAD;
 }
 
 const std::string *FThread::getName() const
@@ -288,13 +586,41 @@ void FThread::setTicksPerSecond(const double newTPS)
 		this->m_noSleepThread = true;
 	else
 	{
+		this->m_sleepTime = std::chrono::microseconds(static_cast<int64_t>(1000000 / newTPS));
 		this->m_noSleepThread = false;
-		this->m_sleepTimeMutex.lock();
-		this->m_sleepTime = std::chrono::microseconds(static_cast<int64_t>(1000000 / this->m_tps));
-		this->m_sleepTimeMutex.unlock();
 	}
 }
 
+FClock *FThread::getClock() const
+{
+	return this->m_clock;
+}
+
+void FThread::setClock(FClock *clock)
+{
+	if (this->m_started)
+		return;
+
+	// the sleeper is attached by start(), a thread that is not running yet must not hold back a virtual clock
+	this->m_clock->detach(&this->m_sleeper);
+	this->m_clock = clock;
+}
+
+FThreadGroup *FThread::getGroup() const
+{
+	return this->m_group;
+}
+
+unsigned long FThread::getGroupTick() const
+{
+	return this->m_groupTick;
+}
+
+long FThread::getFrameIndex() const
+{
+	return static_cast<long>(this->m_groupTick) - static_cast<long>(this->m_groupStage);
+}
+
 unsigned long FThread::getTickCount() const
 {
 	return this->m_tickCount;
@@ -304,3 +630,18 @@ unsigned long FThread::getCurrentTime() const
 {
 	return this->m_tickTime;
 }
+
+const FAllocationStats *FThread::getAllocationStats() const
+{
+	return &this->m_allocationStats;
+}
+
+unsigned long FThread::getStartWaitTime() const
+{
+	return this->m_startWaitTime;
+}
+
+unsigned long FThread::getStartDuration() const
+{
+	return this->m_startDuration;
+}
@@ -11,12 +11,25 @@
 #include <string>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <chrono>
 #include <vector>
 #include <queue>
 #include <atomic>
 #include <functional>
 
+#include "FClock.hpp"
+#include "FMutex.hpp"
+#include "FThreadGroup.hpp"
+#include "FAllocationTracker.hpp"
+
+class FChannelBase;
+
+/**
+ * Size of a cache line used to keep data written by different threads apart.
+ */
+constexpr size_t CACHE_LINE_SIZE = 64;
+
 /**
  * Enum defining how an FThread will handle the task queue.
  */
@@ -36,11 +49,28 @@ enum TaskQueueMode
 	QUEUE_DISABLED
 };
 
+/**
+ * Enum defining what happens to the pending tasks of an FThread when it stops.
+ */
+enum ShutdownPolicy
+{
+	/**
+	 * Pending tasks are dropped without being executed.
+	 */
+	SHUTDOWN_DISCARD_QUEUE,
+	/**
+	 * Pending tasks are executed one last time before the onStop() method is called.
+	 */
+	SHUTDOWN_DRAIN_QUEUE
+};
+
 /**
  * Class representing a thread with advanced features.
  */
 class FThread
 {
+	friend class FThreadGroup;
+
 protected:
 
 	/**
@@ -48,9 +78,22 @@ protected:
 	 */
 	static std::vector<FThread *> *INSTANCES;
 	/**
-	 * Mutex for the {@link #INSTANCES} list.
+	 * Mutex for the {@link #INSTANCES} list and the start dependency graph.
+	 *
+	 * <p>The start dependency graph consists of {@link #m_dependencies}, {@link #m_dependents}, {@link #m_pendingDependencies} and
+	 * {@link #m_initialized} of every FThread.</p>
 	 */
-	static std::mutex *INSTANCES_MUTEX;
+	static FMutex *INSTANCES_MUTEX;
+	/**
+	 * Condition that is notified every time an FThread has finished.
+	 *
+	 * <p>Must be used together with {@link #INSTANCES_MUTEX}.</p>
+	 */
+	static std::condition_variable_any *INSTANCES_CONDITION;
+	/**
+	 * The FThread running on the calling thread or <code>nullptr</code>.
+	 */
+	static thread_local FThread *CURRENT_THREAD;
 
 	/**
 	 * The name of the thread.
@@ -63,23 +106,35 @@ protected:
 	/**
 	 * A list with pointers to the FThreads this FThread is waiting for before starting.
 	 */
-	std::vector<FThread *> m_waitingList;
+	std::vector<FThread *> m_dependencies;
 	/**
-	 * Mutex for the {@link #m_waitingList} list.
+	 * A list with pointers to the FThreads that are waiting for this FThread before starting.
 	 */
-	std::mutex m_waitingListMutex;
+	std::vector<FThread *> m_dependents;
 	/**
-	 * A pointer to the front task queue that will be processed when {@link #processTaskQueue()} is called.
+	 * The number of FThreads in {@link #m_dependencies} that have not finished their {@link #onStart()} yet.
 	 */
-	std::queue<std::function<void()>> *m_frontTaskQueue;
+	unsigned int m_pendingDependencies;
 	/**
-	 * A pointer to the back task queue where new tasks will be added to when {@link #addTask()} is called.
+	 * Whether the FThread has finished its {@link #onStart()} method and not stopped yet.
 	 */
-	std::queue<std::function<void()>> *m_backTaskQueue;
+	bool m_initialized;
 	/**
-	 * Mutes for the {@link #m_backTaskQueue} queue.
+	 * Condition that is notified when {@link #m_pendingDependencies} reaches zero.
+	 */
+	std::condition_variable_any m_startCondition;
+	/**
+	 * The time in microseconds the FThread waited for its dependencies before starting.
+	 */
+	std::atomic_ulong m_startWaitTime;
+	/**
+	 * The time in microseconds the {@link #onStart()} method of the FThread took.
 	 */
-	std::mutex m_taskQueueMutex;
+	std::atomic_ulong m_startDuration;
+	/**
+	 * A list with pointers to the channels the FThread drains before every tick.
+	 */
+	std::vector<FChannelBase *> m_channels;
 	/**
 	 * The threshold of the task queue.
 	 *
@@ -93,33 +148,36 @@ protected:
 	 */
 	TaskQueueMode m_taskQueueMode;
 	/**
-	 * The ticks per second this FThread tries to achieve.
+	 * Whether the thread destroys itself when it has stopped or not.
 	 */
-	double m_tps;
+	bool m_selfDestructing;
 	/**
-	 * The average sleep time this FThread has to achieve the needed tps defined in {@link #m_tps}.
+	 * A pointer to the clock the FThread ticks and sleeps with.
 	 */
-	std::chrono::duration<long, std::micro> m_sleepTime;
+	FClock *m_clock;
 	/**
-	 * The mutex of the sleep time.
+	 * A pointer to the group the FThread ticks in lockstep with or <code>nullptr</code>.
 	 */
-	std::mutex m_sleepTimeMutex;
+	FThreadGroup *m_group;
 	/**
-	 * Whether the thread does not sleep or sleep.
+	 * The offset of the ticks of the FThread relative to the ticks of its group.
 	 */
-	std::atomic_bool m_noSleepThread;
+	std::chrono::microseconds m_phaseOffset;
 	/**
-	 * The amount of ticks the FThread has ticked.
+	 * The pipeline stage of the FThread in its group.
 	 */
-	std::atomic_ulong m_tickCount;
+	unsigned int m_groupStage;
 	/**
-	 * The time of the current tick in milliseconds;
+	 * Whether the barrier of the group waits for the FThread, from {@link FThreadGroup#addMember()} or {@link #start()}
+	 * until it leaves the group.
 	 */
-	std::atomic_ulong m_tickTime;
+	bool m_expectedByGroup;
 	/**
 	 * Whether the FThread has started or not.
+	 *
+	 * <p>Starts the cache line of the state that is read by producers and observers but rarely written.</p>
 	 */
-	std::atomic_bool m_started;
+	alignas(CACHE_LINE_SIZE) std::atomic_bool m_started;
 	/**
 	 * Whether the FThread is running or not.
 	 */
@@ -129,10 +187,69 @@ protected:
 	 */
 	std::atomic_bool m_stopping;
 	/**
-	 * Whether the thread destroys itself when it has stopped or not.
+	 * What happens to the pending tasks when the FThread stops.
 	 */
-	bool m_selfDestructing;
-
+	std::atomic<ShutdownPolicy> m_shutdownPolicy;
+	/**
+	 * Whether the thread does not sleep or sleep.
+	 */
+	std::atomic_bool m_noSleepThread;
+	/**
+	 * The ticks per second this FThread tries to achieve.
+	 */
+	std::atomic<double> m_tps;
+	/**
+	 * The average sleep time this FThread has to achieve the needed tps defined in {@link #m_tps}.
+	 */
+	std::atomic<std::chrono::microseconds> m_sleepTime;
+	/**
+	 * Mutes for the {@link #m_backTaskQueue} queue.
+	 *
+	 * <p>Starts the cache line written by producers when they add tasks.</p>
+	 */
+	alignas(CACHE_LINE_SIZE) FMutex m_taskQueueMutex;
+	/**
+	 * A pointer to the back task queue where new tasks will be added to when {@link #addTask()} is called.
+	 */
+	std::queue<std::function<void()>> *m_backTaskQueue;
+	/**
+	 * A pointer to the front task queue that will be processed when {@link #processTaskQueue()} is called.
+	 *
+	 * <p>Starts the cache line that is only written by the FThread itself while processing tasks.</p>
+	 */
+	alignas(CACHE_LINE_SIZE) std::queue<std::function<void()>> *m_frontTaskQueue;
+	/**
+	 * The task queue tasks are added to when {@link #addTask()} is called by the FThread itself.
+	 *
+	 * <p>Only accessed by the FThread itself, so adding and processing these tasks does not need any synchronization.</p>
+	 */
+	std::queue<std::function<void()>> m_localTaskQueue;
+	/**
+	 * The amount of ticks the FThread has ticked.
+	 *
+	 * <p>Starts the cache line written by the FThread once per tick and read by observers.</p>
+	 */
+	alignas(CACHE_LINE_SIZE) std::atomic_ulong m_tickCount;
+	/**
+	 * The time of the current tick in milliseconds;
+	 */
+	std::atomic_ulong m_tickTime;
+	/**
+	 * The group tick the FThread is currently executing.
+	 */
+	std::atomic_ulong m_groupTick;
+	/**
+	 * The sleeper the FThread sleeps on between ticks and while waiting for tasks.
+	 *
+	 * <p>Starts the cache lines touched by threads waking up the FThread.</p>
+	 */
+	alignas(CACHE_LINE_SIZE) FClockSleeper m_sleeper;
+	/**
+	 * The heap allocations of the FThread per tick phase.
+	 *
+	 * <p>Starts the cache lines written by the FThread on every allocation when allocation tracking is enabled.</p>
+	 */
+	alignas(CACHE_LINE_SIZE) FAllocationStats m_allocationStats;
 	/**
 	 * Method which will be the start method of the {@link #m_thread}.
 	 */
@@ -143,6 +260,11 @@ protected:
 	 */
 	void run();
 
+	/**
+	 * Executes one tick, that is the task queue, the channels and the {@link #onTick()} method.
+	 */
+	void tick();
+
 	/**
 	 * Method which is called when the FThread is about to start.
 	 */
@@ -162,17 +284,67 @@ protected:
 	virtual void onStop() = 0;
 
 	/**
-	 * Removes the given FThread from the waiting list of this FThread.
+	 * Checks whether this FThread directly or indirectly waits for the given FThread before starting.
+	 *
+	 * <p>{@link #INSTANCES_MUTEX} must be locked when calling this method.</p>
+	 *
+	 * @param thread A pointer to the {@link FThread} that will be searched for in the dependencies of this FThread.
+	 *
+	 * @return <code>true</code> when the given FThread is reachable through the dependencies of this FThread.
+	 */
+	[[nodiscard]] bool dependsOn(const FThread *thread) const;
+
+	/**
+	 * Removes this FThread from the start dependency graph.
 	 *
-	 * @param thread A pointer to the {@link FThread} that will be removed from this FThread's waiting list.
+	 * <p>{@link #INSTANCES_MUTEX} must be locked when calling this method.</p>
 	 */
-	void removeFromWaitingList(FThread *thread);
+	void detachFromStartGraph();
 
 	/**
 	 * Processes the task queue of the FThread.
+	 *
+	 * <p>Tasks added by other threads are processed first, followed by the tasks the FThread added itself before the
+	 * local part of the pass started.</p>
 	 */
 	void processTaskQueue();
 
+	/**
+	 * Passes the messages of every channel of the FThread to the handlers of the channels.
+	 *
+	 * @return the number of drained messages.
+	 */
+	size_t drainChannels();
+
+	/**
+	 * Sleeps until the given time is reached.
+	 *
+	 * <p>Unlike a plain sleep on the clock, {@link #wake()} does not end this sleep early, only {@link #stop()} does.</p>
+	 *
+	 * @param sleepUntil The time in microseconds the FThread sleeps until.
+	 */
+	void sleepUntilTick(const std::chrono::microseconds &sleepUntil);
+
+	/**
+	 * Signals the FThread to stop and wakes it up from any sleep or startup wait.
+	 *
+	 * <p>{@link #INSTANCES_MUTEX} must be locked when calling this method.</p>
+	 *
+	 * @param policy The {@link ShutdownPolicy} for the pending tasks of the FThread.
+	 */
+	void interrupt(ShutdownPolicy policy);
+
+	/**
+	 * Checks whether the given FThread still exists and has not finished yet.
+	 *
+	 * <p>{@link #INSTANCES_MUTEX} must be locked when calling this method.</p>
+	 *
+	 * @param thread A pointer to the FThread that will be checked.
+	 *
+	 * @return <code>true</code> when the FThread is still alive.
+	 */
+	[[nodiscard]] static bool isAlive(const FThread *thread);
+
 public:
 	/**
 	 * Constructs a new FThread.
@@ -194,24 +366,88 @@ public:
 	/**
 	 * Starts the FThread.
 	 *
+	 * <p>The {@link #onStart()} method is called as soon as every FThread in <code>waitFor</code> has finished its own
+	 * {@link #onStart()} method. FThreads without dependencies start immediately, so independent FThreads start in parallel.</p>
+	 *
 	 * @param waitForSize The number of FThreads this FThread is waiting for before actually starting.
 	 * @param waitFor A pointer array to the FThreads this FThread is waiting for.
 	 *
-	 * @return the std::thread this FThread is wrapped around.
+	 * @return the std::thread this FThread is wrapped around or <code>nullptr</code> if waiting for the given FThreads would
+	 * result in a dependency cycle.
 	 */
 	std::thread *start(unsigned int waitForSize = 0, FThread **waitFor = nullptr);
 
 	/**
 	 * Adds a task to the task queue of the FThread.
 	 *
+	 * <p>Tasks the FThread adds itself, e.g. from {@link #onTick()} or from other tasks, bypass the synchronized queue and
+	 * are executed in the next {@link #processTaskQueue()} pass without any locking. Tasks it adds from {@link #onStart()}
+	 * are kept for its first tick, tasks it adds once it stopped running, e.g. from {@link #onStop()}, are dropped.</p>
+	 *
 	 * @param task The task that will be added to the queue of this FThread.
+	 * @return <code>false</code> if the task was dropped because the FThread is not running or has no task queue.
 	 */
-	void addTask(const std::function<void()> &task);
+	bool addTask(const std::function<void()> &task);
 
 	/**
 	 * Stops the FThread.
+	 *
+	 * <p>A sleeping FThread or an FThread waiting for its dependencies is woken up immediately.</p>
+	 *
+	 * @param policy The {@link ShutdownPolicy} for the pending tasks of the FThread.
+	 */
+	void stop(ShutdownPolicy policy = SHUTDOWN_DISCARD_QUEUE);
+
+	/**
+	 * Wakes up the FThread if it is currently sleeping while waiting for tasks or channel messages.
+	 */
+	void wake();
+
+	/**
+	 * Adds a channel the FThread drains before every tick.
+	 *
+	 * <p>Channels are drained after the task queue and before {@link #onTick()}. {@link TaskQueueMode#QUEUE_ONLY} FThreads
+	 * drain their channels whenever they are woken up. Has no effect while the FThread is started.</p>
+	 *
+	 * @param channel A pointer to the channel.
 	 */
-	void stop();
+	void addChannel(FChannelBase *channel);
+
+	/**
+	 * Stops the given FThreads in reverse start dependency order.
+	 *
+	 * <p>An FThread is only stopped after every FThread of the group that waited for it on start has finished.
+	 * FThreads which are not part of the group are not waited for.</p>
+	 *
+	 * @param size The number of FThreads in the group.
+	 * @param threads A pointer array to the FThreads that will be stopped.
+	 * @param timeout The time the whole group has to finish.
+	 * @param policy The {@link ShutdownPolicy} for the pending tasks of the FThreads.
+	 *
+	 * @return <code>true</code> when every FThread finished before the timeout, <code>false</code> if the timeout was
+	 * reached. In that case every remaining FThread has been signaled to stop nonetheless.
+	 */
+	static bool stopGroup(unsigned int size, FThread **threads, const std::chrono::milliseconds &timeout,
+			ShutdownPolicy policy = SHUTDOWN_DISCARD_QUEUE);
+
+	/**
+	 * Stops all started FThreads in reverse start dependency order.
+	 *
+	 * @param timeout The time all FThreads have to finish.
+	 * @param policy The {@link ShutdownPolicy} for the pending tasks of the FThreads.
+	 *
+	 * @return <code>true</code> when every FThread finished before the timeout.
+	 *
+	 * @see #stopGroup() for a detailed description.
+	 */
+	static bool stopAll(const std::chrono::milliseconds &timeout, ShutdownPolicy policy = SHUTDOWN_DISCARD_QUEUE);
+
+	/**
+	 * Gets the FThread running on the calling thread.
+	 *
+	 * @return a pointer to the current FThread or <code>nullptr</code> if the calling thread is not an FThread.
+	 */
+	[[nodiscard]] static FThread *getCurrentThread();
 
 	/**
 	 * Gets the name of the FThread.
@@ -255,6 +491,48 @@ public:
 	 */
 	void setTicksPerSecond(double newTPS);
 
+	/**
+	 * Gets the clock this FThread ticks and sleeps with.
+	 *
+	 * @return a pointer to the clock of this FThread.
+	 */
+	[[nodiscard]] FClock *getClock() const;
+
+	/**
+	 * Sets the clock this FThread ticks and sleeps with.
+	 *
+	 * <p>The FThread only becomes a participant of the clock once it is started, so an FThread that is not started yet
+	 * does not hold back an {@link FVirtualClock} for the FThreads that are running. FThreads sharing a virtual clock are
+	 * started while it is paused, see {@link FVirtualClock#pause()}. Has no effect while the FThread is started.</p>
+	 *
+	 * @param clock A pointer to the new clock of the FThread.
+	 */
+	void setClock(FClock *clock);
+
+	/**
+	 * Gets the group this FThread ticks in lockstep with.
+	 *
+	 * @return a pointer to the group of this FThread or <code>nullptr</code>.
+	 */
+	[[nodiscard]] FThreadGroup *getGroup() const;
+
+	/**
+	 * Gets the group tick this FThread is currently executing.
+	 *
+	 * @return the current group tick or zero if this FThread is not part of a group.
+	 */
+	[[nodiscard]] unsigned long getGroupTick() const;
+
+	/**
+	 * Gets the frame this FThread processes in the current group tick.
+	 *
+	 * <p>The frame is the group tick minus the pipeline stage of this FThread. It is negative while the
+	 * pipeline is filling up.</p>
+	 *
+	 * @return the frame this FThread processes.
+	 */
+	[[nodiscard]] long getFrameIndex() const;
+
 	/**
 	 * Gets the tick count of this FThread.
 	 *
@@ -268,6 +546,29 @@ public:
 	 * @return the time of the current tick in milliseconds.
 	 */
 	[[nodiscard]] unsigned long getCurrentTime() const;
+
+	/**
+	 * Gets the heap allocations of this FThread per tick phase.
+	 *
+	 * <p>The counters stay zero unless allocation tracking is compiled in, see {@link FAllocationTracker}.</p>
+	 *
+	 * @return a const pointer to the allocation statistics of this FThread.
+	 */
+	[[nodiscard]] const FAllocationStats *getAllocationStats() const;
+
+	/**
+	 * Gets the time this FThread waited for its dependencies before its {@link #onStart()} method was called.
+	 *
+	 * @return the time waited for dependencies in microseconds.
+	 */
+	[[nodiscard]] unsigned long getStartWaitTime() const;
+
+	/**
+	 * Gets the time the {@link #onStart()} method of this FThread took.
+	 *
+	 * @return the duration of the {@link #onStart()} method in microseconds.
+	 */
+	[[nodiscard]] unsigned long getStartDuration() const;
 };
 
 
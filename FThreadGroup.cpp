@@ -0,0 +1,150 @@
+/*
+ * FThreadGroup.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FThreadGroup.hpp"
+#include "FThread.hpp"
+#include <algorithm>
+
+
+//---------------------------------------------------------------------------//
+//                             Thread Group Class                            //
+//---------------------------------------------------------------------------//
+
+FThreadGroup::FThreadGroup(const double ticksPerSecond, const bool synchronized)
+{
+	this->m_mutex.setName("FThreadGroup::m_mutex");
+	this->m_tps = ticksPerSecond;
+	this->m_period = std::chrono::microseconds(static_cast<int64_t>(1000000 / ticksPerSecond));
+	this->m_synchronized = synchronized;
+	this->m_hasEpoch = false;
+	this->m_epoch = std::chrono::microseconds(0);
+	this->m_expectedMembers = 0;
+	this->m_waitingMembers = std::vector<FThread *>();
+	this->m_generation = 0;
+}
+
+void FThreadGroup::addMember(FThread *thread, const std::chrono::microseconds &phaseOffset, const unsigned int stage)
+{
+	if (thread->m_started)
+		return;
+
+	thread->m_group = this;
+	thread->m_phaseOffset = phaseOffset;
+	thread->m_groupStage = stage;
+	thread->setTicksPerSecond(this->m_tps);
+	this->expect(thread);
+}
+
+void FThreadGroup::expect(FThread *thread)
+{
+	if (thread->m_taskQueueMode == QUEUE_ONLY)
+		return;
+
+	this->m_mutex.lock();
+	if (!thread->m_expectedByGroup)
+	{
+		thread->m_expectedByGroup = true;
+		this->m_expectedMembers++;
+	}
+	this->m_mutex.unlock();
+}
+
+unsigned long FThreadGroup::enter(FThread *thread)
+{
+	std::chrono::microseconds now = thread->m_clock->now();
+
+	this->m_mutex.lock();
+	if (!this->m_hasEpoch)
+	{
+		this->m_epoch = now;
+		this->m_hasEpoch = true;
+	}
+
+	unsigned long groupTick = this->m_synchronized ? this->m_generation : this->getTickAt(now, thread->m_phaseOffset);
+	this->m_mutex.unlock();
+
+	return groupTick;
+}
+
+void FThreadGroup::leave(FThread *thread)
+{
+	this->m_mutex.lock();
+	if (thread->m_expectedByGroup)
+	{
+		thread->m_expectedByGroup = false;
+		this->m_expectedMembers--;
+		this->releaseBarrier(nullptr);
+	}
+	this->m_mutex.unlock();
+}
+
+bool FThreadGroup::arriveAndWait(FThread *thread, unsigned long &groupTick)
+{
+	this->m_mutex.lock();
+	const unsigned long generation = this->m_generation;
+	this->m_waitingMembers.push_back(thread);
+	this->releaseBarrier(thread);
+
+	// waiting members sleep on their clock, so a virtual clock can advance the members that still have to tick
+	while (this->m_generation == generation)
+	{
+		if (!thread->m_running)
+		{
+			auto it = std::find(this->m_waitingMembers.begin(), this->m_waitingMembers.end(), thread);
+			if (it != this->m_waitingMembers.end())
+				this->m_waitingMembers.erase(it);
+			this->m_mutex.unlock();
+			return false;
+		}
+
+		this->m_mutex.unlock();
+		thread->m_clock->sleepUntil(&thread->m_sleeper, FClock::FOREVER);
+		this->m_mutex.lock();
+	}
+	this->m_mutex.unlock();
+
+	groupTick = generation;
+	return true;
+}
+
+void FThreadGroup::releaseBarrier(const FThread *caller)
+{
+	if (this->m_waitingMembers.empty() || this->m_waitingMembers.size() < this->m_expectedMembers)
+		return;
+
+	this->m_generation++;
+	for (FThread *member : this->m_waitingMembers)
+	{
+		if (member != caller)
+			member->wake();
+	}
+	this->m_waitingMembers.clear();
+}
+
+std::chrono::microseconds FThreadGroup::getTickTime(const unsigned long groupTick) const
+{
+	return this->m_epoch + this->m_period * groupTick;
+}
+
+unsigned long FThreadGroup::getTickAt(const std::chrono::microseconds &time, const std::chrono::microseconds &phaseOffset) const
+{
+	std::chrono::microseconds sinceEpoch = time - this->m_epoch - phaseOffset;
+	if (sinceEpoch.count() <= 0)
+		return 0;
+
+	return static_cast<unsigned long>(sinceEpoch / this->m_period);
+}
+
+bool FThreadGroup::isSynchronized() const
+{
+	return this->m_synchronized;
+}
+
+double FThreadGroup::getTicksPerSecond() const
+{
+	return this->m_tps;
+}
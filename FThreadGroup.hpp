@@ -0,0 +1,173 @@
+/*
+ * FThreadGroup.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FTHREADGROUP_HPP_
+#define CORE_CONCURRENT_FTHREADGROUP_HPP_
+
+#include <mutex>
+#include <chrono>
+#include <vector>
+
+#include "FMutex.hpp"
+
+class FThread;
+
+/**
+ * Class representing a group of FThreads that tick in lockstep.
+ *
+ * <p>Every member ticks on a shared tick epoch, tick <code>n</code> of a member happens at
+ * <code>epoch + n / ticksPerSecond + phaseOffset</code>. Members of a synchronized group additionally wait for each other
+ * before every tick, so no member starts tick <code>n + 1</code> before every member has finished tick <code>n</code>.</p>
+ *
+ * <p>Members can be arranged as a pipeline by giving them stages. Stage <code>k</code> processes frame <code>n - k</code>
+ * in group tick <code>n</code>, see {@link FThread#getFrameIndex()}. In a synchronized group stage <code>k + 1</code>
+ * therefore always reads the frame stage <code>k</code> finished in the previous tick.</p>
+ */
+class FThreadGroup
+{
+private:
+
+	/**
+	 * The ticks per second of the group.
+	 */
+	double m_tps;
+	/**
+	 * The time between two group ticks.
+	 */
+	std::chrono::microseconds m_period;
+	/**
+	 * Whether the members wait for each other before every tick.
+	 */
+	bool m_synchronized;
+	/**
+	 * Mutex for the epoch and the barrier of the group.
+	 */
+	FMutex m_mutex;
+	/**
+	 * Whether the epoch has been set by the first running member.
+	 */
+	bool m_hasEpoch;
+	/**
+	 * The time of group tick zero.
+	 */
+	std::chrono::microseconds m_epoch;
+	/**
+	 * The number of members the barrier waits for, counted from {@link #addMember()} or their start until they leave.
+	 */
+	unsigned int m_expectedMembers;
+	/**
+	 * A list with pointers to the members waiting at the barrier.
+	 */
+	std::vector<FThread *> m_waitingMembers;
+	/**
+	 * The group tick the barrier is currently collecting members for.
+	 */
+	unsigned long m_generation;
+
+	/**
+	 * Releases the members waiting at the barrier if every expected member has arrived.
+	 *
+	 * <p>{@link #m_mutex} must be locked when calling this method.</p>
+	 *
+	 * @param caller A pointer to the calling member which is not woken up or <code>nullptr</code>.
+	 */
+	void releaseBarrier(const FThread *caller);
+
+public:
+
+	/**
+	 * Constructs a new FThreadGroup.
+	 *
+	 * @param ticksPerSecond The ticks per second every member of the group ticks with.
+	 * @param synchronized Whether the members wait for each other before every tick.
+	 */
+	explicit FThreadGroup(double ticksPerSecond, bool synchronized = false);
+
+	/**
+	 * Adds an FThread to the group.
+	 *
+	 * <p>Must be called before the FThread is started. Every member of a group must use the same clock.
+	 * Members with the task queue mode {@link TaskQueueMode#QUEUE_ONLY} do not tick and ignore the group.</p>
+	 *
+	 * <p>The barrier of a synchronized group waits for the member from now on, so members started one after another
+	 * all execute group tick 0 together. Every member of a synchronized group must therefore be started.</p>
+	 *
+	 * @param thread A pointer to the FThread that will be added.
+	 * @param phaseOffset The offset of the ticks of the FThread relative to the group ticks.
+	 * @param stage The pipeline stage of the FThread.
+	 */
+	void addMember(FThread *thread, const std::chrono::microseconds &phaseOffset = std::chrono::microseconds(0), unsigned int stage = 0);
+
+	/**
+	 * Makes the barrier wait for a member until it leaves, does nothing if it already does.
+	 *
+	 * @param thread A pointer to the member.
+	 */
+	void expect(FThread *thread);
+
+	/**
+	 * Registers a member that enters its main loop.
+	 *
+	 * @param thread A pointer to the member.
+	 *
+	 * @return the first group tick the member will execute.
+	 */
+	unsigned long enter(FThread *thread);
+
+	/**
+	 * Unregisters a member that leaves its main loop or stopped before entering it, so the barrier stops waiting for it.
+	 *
+	 * @param thread A pointer to the member.
+	 */
+	void leave(FThread *thread);
+
+	/**
+	 * Waits until every expected member has arrived at the barrier.
+	 *
+	 * @param thread A pointer to the calling member.
+	 * @param groupTick Set to the group tick the member executes next.
+	 *
+	 * @return <code>false</code> if the member was stopped while waiting.
+	 */
+	bool arriveAndWait(FThread *thread, unsigned long &groupTick);
+
+	/**
+	 * Gets the time the given group tick is scheduled at.
+	 *
+	 * @param groupTick The group tick.
+	 *
+	 * @return the time of the group tick in microseconds.
+	 */
+	[[nodiscard]] std::chrono::microseconds getTickTime(unsigned long groupTick) const;
+
+	/**
+	 * Gets the group tick a member with the given phase offset has to execute next at the given time.
+	 *
+	 * @param time The current time in microseconds.
+	 * @param phaseOffset The phase offset of the member.
+	 *
+	 * @return the group tick scheduled at or before the given time.
+	 */
+	[[nodiscard]] unsigned long getTickAt(const std::chrono::microseconds &time, const std::chrono::microseconds &phaseOffset) const;
+
+	/**
+	 * Gets whether the members wait for each other before every tick.
+	 *
+	 * @return <code>true</code> when the group is synchronized.
+	 */
+	[[nodiscard]] bool isSynchronized() const;
+
+	/**
+	 * Gets the ticks per second of the group.
+	 *
+	 * @return the ticks per second of the group.
+	 */
+	[[nodiscard]] double getTicksPerSecond() const;
+};
+
+
+#endif /* CORE_CONCURRENT_FTHREADGROUP_HPP_ */
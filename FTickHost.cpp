@@ -0,0 +1,392 @@
+/*
+ * FTickHost.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FTickHost.hpp"
+#include "FLogger.hpp"
+#include <algorithm>
+
+
+//---------------------------------------------------------------------------//
+//                                Ticker Class                               //
+//---------------------------------------------------------------------------//
+
+FTicker::FTicker(const std::string &name, const double ticksPerSecond, const unsigned int taskQueueThreshold)
+{
+	this->m_name = name;
+	this->m_taskQueueMutex.setName(name + "::m_taskQueueMutex");
+	this->m_host = nullptr;
+	this->m_running = false;
+	this->m_stopping = false;
+	this->m_initialized = false;
+	this->m_scheduled = false;
+	this->m_nextTick = std::chrono::microseconds(0);
+	this->m_taskQueueThreshold = taskQueueThreshold;
+	this->m_frontTaskQueue = new std::queue<std::function<void()>>();
+	this->m_backTaskQueue = new std::queue<std::function<void()>>();
+	this->m_tickCount = 0;
+	this->m_tickTime = 0;
+	this->setTicksPerSecond(ticksPerSecond);
+}
+
+FTicker::~FTicker()
+{
+	if (this->m_host != nullptr)
+		FLogger::error(this->m_name, "destroyed while still hosted, it must be stopped and removed first!");
+
+	delete this->m_frontTaskQueue;
+	delete this->m_backTaskQueue;
+}
+
+void FTicker::processTaskQueue()
+{
+	this->m_taskQueueMutex.lock();
+	size_t pendingTasks = this->m_backTaskQueue->size();
+	std::queue<std::function<void()>> *tmp = this->m_frontTaskQueue;
+	this->m_frontTaskQueue = this->m_backTaskQueue;
+	this->m_backTaskQueue = tmp;
+	this->m_taskQueueMutex.unlock();
+
+	if (pendingTasks > this->m_taskQueueThreshold)
+		FLogger::warning(this->m_name, "task queue is bigger than the threshold: {}/{}!", pendingTasks, this->m_taskQueueThreshold);
+
+	while (!this->m_frontTaskQueue->empty())
+	{
+		this->m_frontTaskQueue->front()();
+		this->m_frontTaskQueue->pop();
+	}
+}
+
+void FTicker::addTask(const std::function<void()> &task)
+{
+	if (!this->m_running)
+		return;
+
+	this->m_taskQueueMutex.lock();
+	this->m_backTaskQueue->push(task);
+	this->m_taskQueueMutex.unlock();
+}
+
+void FTicker::stop()
+{
+	this->m_stopping = true;
+	this->m_running = false;
+
+	FTickHost *host = this->m_host;
+	if (host != nullptr)
+		host->expedite(this);
+}
+
+const std::string *FTicker::getName() const
+{
+	return &this->m_name;
+}
+
+FTickHost *FTicker::getHost() const
+{
+	return this->m_host;
+}
+
+bool FTicker::isRunning() const
+{
+	return this->m_running;
+}
+
+bool FTicker::isStopping() const
+{
+	return this->m_stopping;
+}
+
+double FTicker::getTicksPerSecond() const
+{
+	return this->m_tps;
+}
+
+void FTicker::setTicksPerSecond(const double newTPS)
+{
+	this->m_tps = newTPS <= 0.0 ? -1.0 : newTPS;
+	if (this->m_tps == -1.0)
+		this->m_period = std::chrono::microseconds(0);
+	else
+		this->m_period = std::chrono::microseconds(static_cast<int64_t>(1000000 / newTPS));
+}
+
+unsigned long FTicker::getTickCount() const
+{
+	return this->m_tickCount;
+}
+
+unsigned long FTicker::getCurrentTime() const
+{
+	return this->m_tickTime;
+}
+
+
+//---------------------------------------------------------------------------//
+//                               Tick Host Class                             //
+//---------------------------------------------------------------------------//
+
+FTickHost::Worker::Worker(const std::string &name, FTickHost *host, const size_t index)
+		: FThread(name, -1.0, QUEUE_DISABLED)
+{
+	this->m_host = host;
+	this->m_index = index;
+}
+
+void FTickHost::Worker::onStart()
+{
+}
+
+void FTickHost::Worker::onTick(const unsigned long, const unsigned long)
+{
+	std::chrono::microseconds sleepUntil = this->m_host->step(this->m_index);
+	if (sleepUntil.count() != 0)
+		this->m_clock->sleepUntil(&this->m_sleeper, sleepUntil);
+}
+
+void FTickHost::Worker::onStop()
+{
+}
+
+FTickHost::FTickHost(const std::string &name, const unsigned int workerCount)
+{
+	this->m_name = name;
+	this->m_mutex.setName(name + "::m_mutex");
+	this->m_tickers = std::vector<FTicker *>();
+	this->m_schedule = std::vector<FTicker *>();
+	this->m_workers = std::vector<Worker *>();
+	this->m_threads = std::vector<std::thread *>();
+	this->m_workerDeadlines = std::vector<std::chrono::microseconds>(std::max(workerCount, 1u), FClock::FOREVER);
+	this->m_started = false;
+
+	for (size_t n = 0; n < this->m_workerDeadlines.size(); n++)
+		this->m_workers.push_back(new Worker(name + "-" + std::to_string(n), this, n));
+}
+
+FTickHost::~FTickHost()
+{
+	this->stop();
+
+	for (Worker *worker : this->m_workers)
+		delete worker;
+}
+
+bool FTickHost::start()
+{
+	if (this->m_started)
+		return false;
+
+	this->m_started = true;
+	for (Worker *worker : this->m_workers)
+		this->m_threads.push_back(worker->start());
+	return true;
+}
+
+void FTickHost::stop()
+{
+	if (!this->m_started)
+		return;
+
+	for (Worker *worker : this->m_workers)
+		worker->stop();
+	for (std::thread *thread : this->m_threads)
+	{
+		thread->join();
+		delete thread;
+	}
+	this->m_threads.clear();
+	this->m_started = false;
+
+	// no worker is running anymore, so the remaining FTickers are stopped right here
+	std::vector<FTicker *> tickers;
+	this->m_mutex.lock();
+	tickers.swap(this->m_tickers);
+	this->m_schedule.clear();
+	this->m_mutex.unlock();
+
+	for (FTicker *ticker : tickers)
+	{
+		ticker->m_running = false;
+		if (ticker->m_initialized)
+			ticker->onStop();
+		ticker->m_scheduled = false;
+		ticker->m_stopping = false;
+		ticker->m_host = nullptr;
+	}
+}
+
+bool FTickHost::addTicker(FTicker *ticker)
+{
+	this->m_mutex.lock();
+	if (ticker->m_host != nullptr)
+	{
+		this->m_mutex.unlock();
+		FLogger::error(this->m_name, "{} is hosted already!", ticker->m_name);
+		return false;
+	}
+
+	ticker->m_host = this;
+	ticker->m_stopping = false;
+	ticker->m_initialized = false;
+	ticker->m_running = true;
+	ticker->m_nextTick = this->getClock()->now();
+	ticker->m_scheduled = true;
+
+	this->m_tickers.push_back(ticker);
+	this->m_schedule.push_back(ticker);
+	std::push_heap(this->m_schedule.begin(), this->m_schedule.end(), isLater);
+	this->wakeWorker(ticker->m_nextTick);
+	this->m_mutex.unlock();
+	return true;
+}
+
+bool FTickHost::isLater(const FTicker *first, const FTicker *second)
+{
+	return first->m_nextTick > second->m_nextTick;
+}
+
+std::chrono::microseconds FTickHost::step(const size_t worker)
+{
+	FClock *clock = this->getClock();
+	std::chrono::microseconds now = clock->now();
+
+	this->m_mutex.lock();
+	if (this->m_schedule.empty())
+	{
+		this->m_workerDeadlines[worker] = FClock::FOREVER;
+		this->m_mutex.unlock();
+		return FClock::FOREVER;
+	}
+
+	FTicker *ticker = this->m_schedule.front();
+	std::chrono::microseconds nextTick = ticker->m_nextTick;
+	if (nextTick > now)
+	{
+		this->m_workerDeadlines[worker] = nextTick;
+		this->m_mutex.unlock();
+		return nextTick;
+	}
+
+	std::pop_heap(this->m_schedule.begin(), this->m_schedule.end(), isLater);
+	this->m_schedule.pop_back();
+	ticker->m_scheduled = false;
+	this->m_workerDeadlines[worker] = std::chrono::microseconds(0);
+	this->m_mutex.unlock();
+
+	if (!ticker->m_stopping)
+	{
+		if (!ticker->m_initialized)
+		{
+			ticker->onStart();
+			ticker->m_initialized = true;
+			// the pacing starts with the first tick, not when the FTicker was added
+			nextTick = now;
+		}
+
+		ticker->m_tickTime = now.count();
+		ticker->processTaskQueue();
+		ticker->onTick(ticker->m_tickTime, ticker->m_tickCount++);
+	}
+
+	if (ticker->m_stopping)
+	{
+		this->finish(ticker);
+		return std::chrono::microseconds(0);
+	}
+
+	// an FTicker that fell behind by more than one tick skips the missed ticks instead of catching up
+	std::chrono::microseconds period = ticker->m_period;
+	nextTick += period;
+	now = clock->now();
+	if (nextTick + period < now)
+		nextTick = now;
+
+	this->m_mutex.lock();
+	ticker->m_nextTick = ticker->m_stopping ? now : nextTick;
+	ticker->m_scheduled = true;
+	this->m_schedule.push_back(ticker);
+	std::push_heap(this->m_schedule.begin(), this->m_schedule.end(), isLater);
+	// a worker that found the schedule empty sleeps forever and has to learn about the new deadline
+	this->wakeWorker(ticker->m_nextTick);
+	this->m_mutex.unlock();
+
+	return std::chrono::microseconds(0);
+}
+
+void FTickHost::finish(FTicker *ticker)
+{
+	{
+		std::lock_guard<FMutex> lock(ticker->m_taskQueueMutex);
+		std::queue<std::function<void()>>().swap(*ticker->m_backTaskQueue);
+	}
+
+	if (ticker->m_initialized)
+		ticker->onStop();
+
+	this->m_mutex.lock();
+	this->m_tickers.erase(std::find(this->m_tickers.begin(), this->m_tickers.end(), ticker));
+	ticker->m_stopping = false;
+	ticker->m_host = nullptr;
+	this->m_mutex.unlock();
+}
+
+void FTickHost::expedite(FTicker *ticker)
+{
+	this->m_mutex.lock();
+	if (ticker->m_scheduled && ticker->m_host == this)
+	{
+		ticker->m_nextTick = std::chrono::microseconds(0);
+		std::make_heap(this->m_schedule.begin(), this->m_schedule.end(), isLater);
+		this->wakeWorker(ticker->m_nextTick);
+	}
+	this->m_mutex.unlock();
+}
+
+void FTickHost::wakeWorker(const std::chrono::microseconds &deadline)
+{
+	size_t latest = 0;
+	for (size_t n = 1; n < this->m_workerDeadlines.size(); n++)
+	{
+		if (this->m_workerDeadlines[n] > this->m_workerDeadlines[latest])
+			latest = n;
+	}
+
+	if (this->m_workerDeadlines[latest] > deadline)
+	{
+		this->m_workerDeadlines[latest] = deadline;
+		this->m_workers[latest]->wake();
+	}
+}
+
+const std::string *FTickHost::getName() const
+{
+	return &this->m_name;
+}
+
+size_t FTickHost::getTickerCount()
+{
+	std::lock_guard<FMutex> lock(this->m_mutex);
+	return this->m_tickers.size();
+}
+
+size_t FTickHost::getWorkerCount() const
+{
+	return this->m_workers.size();
+}
+
+FClock *FTickHost::getClock() const
+{
+	return this->m_workers.front()->getClock();
+}
+
+void FTickHost::setClock(FClock *clock)
+{
+	if (this->m_started)
+		return;
+
+	for (Worker *worker : this->m_workers)
+		worker->setClock(clock);
+}
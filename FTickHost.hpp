@@ -0,0 +1,412 @@
+/*
+ * FTickHost.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FTICKHOST_HPP_
+#define CORE_CONCURRENT_FTICKHOST_HPP_
+
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <queue>
+#include <atomic>
+#include <functional>
+
+#include "FThread.hpp"
+
+class FTickHost;
+
+/**
+ * Class representing a logical thread that ticks on the worker threads of an {@link FTickHost}.
+ *
+ * <p>An FTicker behaves like an FThread with {@link TaskQueueMode#QUEUE_ENABLED}, but does not own an OS thread. Its
+ * {@link #onStart()}, {@link #onTick()} and {@link #onStop()} methods are called by whichever worker of the host picks
+ * it up, never by two workers at the same time.</p>
+ */
+class FTicker
+{
+	friend class FTickHost;
+
+private:
+
+	/**
+	 * The name of the FTicker.
+	 */
+	std::string m_name;
+	/**
+	 * The host the FTicker is currently scheduled on or <code>nullptr</code>.
+	 */
+	std::atomic<FTickHost *> m_host;
+	/**
+	 * The ticks per second the FTicker tries to achieve.
+	 */
+	std::atomic<double> m_tps;
+	/**
+	 * The time between two ticks, zero if the FTicker ticks as fast as possible.
+	 */
+	std::atomic<std::chrono::microseconds> m_period;
+	/**
+	 * Whether the FTicker accepts tasks.
+	 */
+	std::atomic_bool m_running;
+	/**
+	 * Whether the FTicker will be removed from its host.
+	 */
+	std::atomic_bool m_stopping;
+	/**
+	 * Whether the {@link #onStart()} method has been called.
+	 */
+	bool m_initialized;
+	/**
+	 * Whether the FTicker is waiting in the schedule of its host. Guarded by the mutex of the host.
+	 */
+	bool m_scheduled;
+	/**
+	 * The time of the next tick. Guarded by the mutex of the host.
+	 */
+	std::chrono::microseconds m_nextTick;
+	/**
+	 * The threshold of the task queue.
+	 */
+	unsigned int m_taskQueueThreshold;
+	/**
+	 * Mutex for the task queue of the FTicker.
+	 */
+	FMutex m_taskQueueMutex;
+	/**
+	 * The queue the tasks are executed from.
+	 */
+	std::queue<std::function<void()>> *m_frontTaskQueue;
+	/**
+	 * The queue new tasks are added to.
+	 */
+	std::queue<std::function<void()>> *m_backTaskQueue;
+	/**
+	 * The tick count of the FTicker.
+	 */
+	std::atomic_ulong m_tickCount;
+	/**
+	 * The time of the current tick.
+	 */
+	std::atomic_ulong m_tickTime;
+
+	/**
+	 * Executes the tasks of the FTicker.
+	 */
+	void processTaskQueue();
+
+protected:
+
+	/**
+	 * Will be executed once before the first tick.
+	 */
+	virtual void onStart() = 0;
+
+	/**
+	 * Will be executed every tick.
+	 *
+	 * @param currentTime The time of the current tick.
+	 * @param currentTick The number of the current tick.
+	 */
+	virtual void onTick(unsigned long currentTime, unsigned long currentTick) = 0;
+
+	/**
+	 * Will be executed once after the last tick.
+	 */
+	virtual void onStop() = 0;
+
+public:
+
+	/**
+	 * Constructs a new FTicker.
+	 *
+	 * @param name A reference to the name of the FTicker.
+	 * @param ticksPerSecond The ticks per second the FTicker tries to achieve, a value of zero or less ticks as fast as possible.
+	 * @param taskQueueThreshold The threshold of the task queue.
+	 */
+	explicit FTicker(const std::string &name, double ticksPerSecond = 50.0, unsigned int taskQueueThreshold = 250);
+
+	/**
+	 * Destroys the FTicker.
+	 *
+	 * <p>The host still refers to a hosted FTicker, so it must have been stopped and removed from its host before, i.e.
+	 * {@link #getHost()} returns <code>nullptr</code>, or its host must have been stopped.</p>
+	 */
+	virtual ~FTicker();
+
+	/**
+	 * Adds a task to the task queue of the FTicker.
+	 *
+	 * <p>The task is executed before the next {@link #onTick()}. Tasks are dropped while the FTicker is not hosted.</p>
+	 *
+	 * @param task The task that will be added to the queue of this FTicker.
+	 */
+	void addTask(const std::function<void()> &task);
+
+	/**
+	 * Stops the FTicker.
+	 *
+	 * <p>The FTicker is removed from its host as soon as a worker picks it up, which happens right away unless every
+	 * worker is busy. Pending tasks are dropped.</p>
+	 */
+	void stop();
+
+	/**
+	 * Gets the name of the FTicker.
+	 *
+	 * @return a const pointer to the name of the FTicker.
+	 */
+	[[nodiscard]] const std::string *getName() const;
+
+	/**
+	 * Gets the host the FTicker is scheduled on.
+	 *
+	 * @return a pointer to the host or <code>nullptr</code>.
+	 */
+	[[nodiscard]] FTickHost *getHost() const;
+
+	/**
+	 * Gets whether this FTicker is running or not.
+	 *
+	 * @return <code>true</code> when the FTicker is hosted and accepts tasks.
+	 */
+	[[nodiscard]] bool isRunning() const;
+
+	/**
+	 * Gets whether this FTicker is stopping or not.
+	 *
+	 * @return <code>true</code> when the FTicker is stopping.
+	 */
+	[[nodiscard]] bool isStopping() const;
+
+	/**
+	 * Gets the ticks per second this FTicker tries to achieve.
+	 *
+	 * @return the ticks per second this FTicker tries to achieve.
+	 */
+	[[nodiscard]] double getTicksPerSecond() const;
+
+	/**
+	 * Sets the ticks per second this FTicker tries to achieve.
+	 *
+	 * <p>The new rate applies after the next tick.</p>
+	 *
+	 * @param newTPS The new ticks per second the FTicker tries to achieve.
+	 */
+	void setTicksPerSecond(double newTPS);
+
+	/**
+	 * Gets the tick count of this FTicker.
+	 *
+	 * @return the tick count if this FTicker.
+	 */
+	[[nodiscard]] unsigned long getTickCount() const;
+
+	/**
+	 * Gets the time of the current tick.
+	 *
+	 * @return the time of the current tick.
+	 */
+	[[nodiscard]] unsigned long getCurrentTime() const;
+};
+
+/**
+ * Class representing a small pool of worker FThreads that tick any number of {@link FTicker}s.
+ *
+ * <p>The FTickers are kept in a schedule ordered by their next tick. Every worker ticks the FTicker with the earliest
+ * deadline and sleeps until the next deadline once no FTicker is due, so the number of OS threads does not grow with
+ * the number of FTickers.</p>
+ *
+ * <p>{@link FThread#getCurrentThread()} returns the worker within the methods of an FTicker. A slow FTicker delays the
+ * FTickers due after it on the same worker, so long running work should stay on dedicated FThreads.</p>
+ */
+class FTickHost
+{
+	friend class FTicker;
+
+private:
+
+	/**
+	 * Worker FThread of an FTickHost.
+	 */
+	class Worker : public FThread
+	{
+	private:
+
+		/**
+		 * A pointer to the host of the worker.
+		 */
+		FTickHost *m_host;
+		/**
+		 * The index of the worker in the host.
+		 */
+		size_t m_index;
+
+	protected:
+
+		void onStart() override;
+
+		void onTick(unsigned long currentTime, unsigned long currentTick) override;
+
+		void onStop() override;
+
+	public:
+
+		Worker(const std::string &name, FTickHost *host, size_t index);
+	};
+
+	/**
+	 * The name of the host.
+	 */
+	std::string m_name;
+	/**
+	 * Mutex for the FTickers, the schedule and the worker deadlines.
+	 */
+	FMutex m_mutex;
+	/**
+	 * A list with pointers to all hosted FTickers.
+	 */
+	std::vector<FTicker *> m_tickers;
+	/**
+	 * Heap with pointers to the waiting FTickers, the FTicker with the earliest tick is at the front.
+	 */
+	std::vector<FTicker *> m_schedule;
+	/**
+	 * A list with pointers to the workers of the host.
+	 */
+	std::vector<Worker *> m_workers;
+	/**
+	 * The std::threads of the workers while the host is started.
+	 */
+	std::vector<std::thread *> m_threads;
+	/**
+	 * The time every worker sleeps until, zero while the worker is ticking.
+	 */
+	std::vector<std::chrono::microseconds> m_workerDeadlines;
+	/**
+	 * Whether the host has been started.
+	 */
+	bool m_started;
+
+	/**
+	 * Compares two FTickers so the earliest tick ends up at the front of the schedule.
+	 */
+	static bool isLater(const FTicker *first, const FTicker *second);
+
+	/**
+	 * Ticks the next due FTicker.
+	 *
+	 * @param worker The index of the calling worker.
+	 *
+	 * @return zero if an FTicker has been ticked, otherwise the time the worker should sleep until.
+	 */
+	std::chrono::microseconds step(size_t worker);
+
+	/**
+	 * Removes a stopping FTicker from the host and calls its {@link FTicker#onStop()} method.
+	 *
+	 * @param ticker A pointer to the FTicker.
+	 */
+	void finish(FTicker *ticker);
+
+	/**
+	 * Makes a stopping FTicker due right away.
+	 *
+	 * @param ticker A pointer to the FTicker.
+	 */
+	void expedite(FTicker *ticker);
+
+	/**
+	 * Wakes the worker sleeping the longest if it sleeps past the given time.
+	 *
+	 * <p>{@link #m_mutex} must be locked when calling this method.</p>
+	 *
+	 * @param deadline The time an FTicker became due.
+	 */
+	void wakeWorker(const std::chrono::microseconds &deadline);
+
+public:
+
+	/**
+	 * Constructs a new FTickHost.
+	 *
+	 * @param name A reference to the name of the host, the workers are named after it.
+	 * @param workerCount The number of worker FThreads.
+	 */
+	explicit FTickHost(const std::string &name, unsigned int workerCount = 1);
+
+	/**
+	 * Destroys the FTickHost and stops it if necessary.
+	 */
+	~FTickHost();
+
+	/**
+	 * Starts the workers of the host.
+	 *
+	 * @return <code>false</code> if the host has been started already.
+	 */
+	bool start();
+
+	/**
+	 * Stops the workers of the host and waits for them.
+	 *
+	 * <p>The {@link FTicker#onStop()} methods of the FTickers still hosted are called on the calling thread afterwards.</p>
+	 */
+	void stop();
+
+	/**
+	 * Adds an FTicker to the host.
+	 *
+	 * <p>The FTicker ticks for the first time as soon as a worker is free. FTickers can be added while the host is
+	 * running.</p>
+	 *
+	 * @param ticker A pointer to the FTicker.
+	 *
+	 * @return <code>false</code> if the FTicker is hosted already.
+	 */
+	bool addTicker(FTicker *ticker);
+
+	/**
+	 * Gets the name of the host.
+	 *
+	 * @return a const pointer to the name of the host.
+	 */
+	[[nodiscard]] const std::string *getName() const;
+
+	/**
+	 * Gets the number of hosted FTickers.
+	 *
+	 * @return the number of hosted FTickers.
+	 */
+	[[nodiscard]] size_t getTickerCount();
+
+	/**
+	 * Gets the number of worker FThreads.
+	 *
+	 * @return the number of worker FThreads.
+	 */
+	[[nodiscard]] size_t getWorkerCount() const;
+
+	/**
+	 * Gets the clock the workers tick and sleep with.
+	 *
+	 * @return a pointer to the clock of the workers.
+	 */
+	[[nodiscard]] FClock *getClock() const;
+
+	/**
+	 * Sets the clock the workers tick and sleep with.
+	 *
+	 * <p>Has no effect while the host is started.</p>
+	 *
+	 * @param clock A pointer to the new clock.
+	 */
+	void setClock(FClock *clock);
+};
+
+
+#endif /* CORE_CONCURRENT_FTICKHOST_HPP_ */
@@ -0,0 +1,225 @@
+/*
+ * FWindow.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#include "FWindow.hpp"
+#include "FLogger.hpp"
+
+
+//---------------------------------------------------------------------------//
+//                                Window Class                               //
+//---------------------------------------------------------------------------//
+
+FWindow::FWindow(const std::string &title, const int width, const int height, const std::vector<float> &vertices,
+		const char *vertexShaderSource, const char *fragmentShaderSource, FContextGroup *contextGroup)
+{
+	this->m_title = title;
+	this->m_width = width;
+	this->m_height = height;
+	this->m_vertices = vertices;
+	this->m_vertexShaderSource = vertexShaderSource;
+	this->m_fragmentShaderSource = fragmentShaderSource;
+	this->m_contextGroup = contextGroup != nullptr ? contextGroup : new FContextGroup();
+	this->m_ownsContextGroup = contextGroup == nullptr;
+	this->m_window = nullptr;
+	this->m_model = {0, 0, 0};
+	this->m_program = nullptr;
+	this->m_glState = FGLState();
+	this->m_swapInterval = -1;
+	this->m_viewportOutdated = false;
+	this->m_redrawRequested = false;
+	this->m_closeRequested = false;
+	this->m_eventOwner = nullptr;
+	this->m_pendingEvents = std::vector<FWindowEvent>();
+	this->m_eventBatchQueued = false;
+	this->m_eventsHeldBack = false;
+}
+
+FWindow::~FWindow()
+{
+	if (this->m_ownsContextGroup)
+		delete this->m_contextGroup;
+}
+
+bool FWindow::createWindow()
+{
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+	GLFWwindow *shareWindow = this->m_contextGroup->getShareWindow();
+	this->m_window = glfwCreateWindow(this->m_width, this->m_height, this->m_title.c_str(), nullptr, shareWindow);
+	if (this->m_window == nullptr)
+	{
+		FLogger::error(this->m_title, "could not create the window!");
+		return false;
+	}
+
+	this->m_contextGroup->addWindow(this->m_window);
+	glfwSetWindowUserPointer(this->m_window, this);
+	return true;
+}
+
+void FWindow::destroyWindow()
+{
+	if (this->m_window == nullptr)
+		return;
+
+	this->m_contextGroup->removeWindow(this->m_window);
+	glfwDestroyWindow(this->m_window);
+	this->m_window = nullptr;
+	this->m_swapInterval = -1;
+}
+
+void FWindow::createResources()
+{
+	glfwMakeContextCurrent(this->m_window);
+	this->m_glState.invalidate();
+
+	this->m_model.vboId = this->m_contextGroup->acquireBuffer(this->m_vertices);
+	this->m_program = this->m_contextGroup->acquireProgram(this->m_vertexShaderSource, this->m_fragmentShaderSource);
+
+	// vertex array objects are not shared between contexts
+	glGenVertexArrays(1, &this->m_model.vaoId);
+	this->m_glState.bindVertexArray(this->m_model.vaoId);
+
+	// the enabled attributes are part of the vertex array object, so drawing only has to bind it
+	this->m_glState.bindBuffer(GL_ARRAY_BUFFER, this->m_model.vboId);
+	glVertexAttribPointer(0, 2, GL_FLOAT, false, sizeof(float) * 5, (const void *) 0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, false, sizeof(float) * 5, (const void *) (sizeof(float) * 2));
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+
+	glFrontFace(GL_CCW);
+	this->m_glState.setEnabled(GL_CULL_FACE, true);
+
+	glViewport(0, 0, this->m_width, this->m_height);
+	this->m_redrawRequested = true;
+}
+
+void FWindow::update(const unsigned long)
+{
+}
+
+void FWindow::requestRedraw()
+{
+	this->m_redrawRequested = true;
+}
+
+bool FWindow::isRedrawRequested() const
+{
+	return this->m_redrawRequested;
+}
+
+void FWindow::render()
+{
+	if (glfwGetCurrentContext() != this->m_window)
+		glfwMakeContextCurrent(this->m_window);
+
+	if (this->m_viewportOutdated)
+	{
+		glViewport(0, 0, this->m_width, this->m_height);
+		this->m_viewportOutdated = false;
+	}
+
+	this->m_redrawRequested = false;
+
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	if (this->m_model.program == 0)
+	{
+		this->m_model.program = this->m_contextGroup->getProgram(this->m_program);
+		if (this->m_model.program == 0)
+		{
+			// polled again during the next tick
+			this->m_redrawRequested = !this->m_contextGroup->hasProgramFailed(this->m_program);
+			this->m_glState.endFrame();
+			return;
+		}
+	}
+
+	// the context only draws this model, so both stay bound and are filtered after the first frame
+	this->m_glState.useProgram(this->m_model.program);
+	this->m_glState.bindVertexArray(this->m_model.vaoId);
+	glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(this->m_vertices.size() / 5));
+	this->m_glState.endFrame();
+}
+
+void FWindow::swap(const int interval)
+{
+	// changing the interval is a driver call on most platforms, so it is only done when the role of the window changes
+	if (this->m_swapInterval != interval)
+	{
+		glfwSwapInterval(interval);
+		this->m_swapInterval = interval;
+	}
+
+	glfwSwapBuffers(this->m_window);
+}
+
+void FWindow::destroyResources()
+{
+	if (this->m_window == nullptr)
+		return;
+
+	glfwMakeContextCurrent(this->m_window);
+
+	glDeleteVertexArrays(1, &this->m_model.vaoId);
+	this->m_contextGroup->releaseBuffer(this->m_model.vboId);
+	if (this->m_program != nullptr)
+		this->m_contextGroup->releaseProgram(this->m_program);
+	this->m_program = nullptr;
+
+	// the main thread cannot destroy a window whose context is still current on another thread
+	glfwMakeContextCurrent(nullptr);
+	this->m_model = {0, 0, 0};
+	this->m_glState.invalidate();
+}
+
+void FWindow::handleEvents(const std::vector<FWindowEvent> &events)
+{
+	for (const FWindowEvent &event : events)
+	{
+		switch (event.type)
+		{
+			case WINDOW_EVENT_CLOSE:
+				this->m_closeRequested = true;
+				break;
+			case WINDOW_EVENT_FRAMEBUFFER_SIZE:
+				this->m_width = event.width;
+				this->m_height = event.height;
+				this->m_viewportOutdated = true;
+				this->m_redrawRequested = true;
+				break;
+			case WINDOW_EVENT_REFRESH:
+				// the window system lost the content of the window, e.g. after it was uncovered
+				this->m_redrawRequested = true;
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+bool FWindow::isCloseRequested() const
+{
+	return this->m_closeRequested;
+}
+
+const std::string *FWindow::getTitle() const
+{
+	return &this->m_title;
+}
+
+GLFWwindow *FWindow::getHandle() const
+{
+	return this->m_window;
+}
+
+const FGLState *FWindow::getGLState() const
+{
+	return &this->m_glState;
+}
@@ -0,0 +1,305 @@
+/*
+ * FWindow.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ */
+
+#ifndef CORE_CONCURRENT_FWINDOW_HPP_
+#define CORE_CONCURRENT_FWINDOW_HPP_
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+#include "FContextGroup.hpp"
+#include "FGLState.hpp"
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+
+class FThread;
+
+/**
+ * Enum defining the type of a window event.
+ */
+enum FWindowEventType
+{
+	WINDOW_EVENT_CLOSE,
+	WINDOW_EVENT_FRAMEBUFFER_SIZE,
+	WINDOW_EVENT_FOCUS,
+	WINDOW_EVENT_REFRESH,
+	WINDOW_EVENT_KEY,
+	WINDOW_EVENT_CHARACTER,
+	WINDOW_EVENT_MOUSE_BUTTON,
+	WINDOW_EVENT_CURSOR_MOVE,
+	WINDOW_EVENT_SCROLL
+};
+
+/**
+ * An input or window event recorded by the {@link FEventPump}.
+ */
+struct FWindowEvent
+{
+	FWindowEventType type;
+	/**
+	 * The time the event was recorded at, taken from the clock of the FThread owning the window.
+	 */
+	unsigned long time;
+	/**
+	 * The cursor position or the scroll offset.
+	 */
+	double x;
+	double y;
+	/**
+	 * The size of the framebuffer.
+	 */
+	int width;
+	int height;
+	/**
+	 * The key, the mouse button or the codepoint of a character.
+	 */
+	int code;
+	int scancode;
+	/**
+	 * The action of a key or mouse button, or whether the window gained the focus.
+	 */
+	int action;
+	int mods;
+};
+
+/**
+ * The GL objects of a model drawn by a window. The buffer and the program are shared with the context group of the window,
+ * the program is 0 until the group has built it.
+ */
+struct Model
+{
+	uint32_t vaoId;
+	uint32_t vboId;
+	uint32_t program;
+};
+
+/**
+ * Class representing a GLFW window with its own GL context that draws a single model.
+ *
+ * <p>The GLFW window is created and destroyed on the main thread, while its GL objects are created, drawn and destroyed
+ * by the FThread rendering it, see {@link FRenderThread}. Events reach the window in batches through
+ * {@link #handleEvents()}. Buffers and programs are shared with the other windows of its {@link FContextGroup}. The
+ * window is only drawn after it requested a redraw through {@link #requestRedraw()}, which
+ * happens when it is created, resized or uncovered. The vertices are interleaved as two position and three color
+ * components.</p>
+ */
+class FWindow
+{
+	friend class FEventPump;
+
+private:
+
+	/**
+	 * The title of the window.
+	 */
+	std::string m_title;
+	/**
+	 * The width of the window.
+	 */
+	int m_width;
+	/**
+	 * The height of the window.
+	 */
+	int m_height;
+	/**
+	 * The vertices of the model.
+	 */
+	std::vector<float> m_vertices;
+	/**
+	 * The source of the vertex shader.
+	 */
+	const char *m_vertexShaderSource;
+	/**
+	 * The source of the fragment shader.
+	 */
+	const char *m_fragmentShaderSource;
+	/**
+	 * The context group sharing the buffer and the program of the window.
+	 */
+	FContextGroup *m_contextGroup;
+	/**
+	 * Whether the context group has been created by the window for itself.
+	 */
+	bool m_ownsContextGroup;
+	/**
+	 * The GLFW window or <code>nullptr</code> while the window is not created.
+	 */
+	GLFWwindow *m_window;
+	/**
+	 * The model of the window.
+	 */
+	Model m_model;
+	/**
+	 * The program of the model in the context group, <code>nullptr</code> while the GL objects do not exist.
+	 */
+	FContextGroup::Program *m_program;
+	/**
+	 * The state of the context of the window, filtering redundant state changes of every frame.
+	 */
+	FGLState m_glState;
+	/**
+	 * The swap interval currently set for the context of the window, -1 if it has not been set yet.
+	 */
+	int m_swapInterval;
+	/**
+	 * Whether the viewport has to be updated to the size of the window before the next draw.
+	 */
+	bool m_viewportOutdated;
+	/**
+	 * Whether the content of the window changed since it was drawn the last time.
+	 */
+	bool m_redrawRequested;
+	/**
+	 * Whether the user requested to close the window.
+	 */
+	std::atomic_bool m_closeRequested;
+	/**
+	 * The FThread the events of the window are delivered to. Only used by the event pump.
+	 */
+	FThread *m_eventOwner;
+	/**
+	 * The events recorded since the last batch. Only used by the event pump.
+	 */
+	std::vector<FWindowEvent> m_pendingEvents;
+	/**
+	 * Whether a batch of events is waiting in the task queue of the owner.
+	 */
+	std::atomic_bool m_eventBatchQueued;
+	/**
+	 * Whether events are waiting in {@link #m_pendingEvents} for the queued batch to be handled.
+	 */
+	std::atomic_bool m_eventsHeldBack;
+
+public:
+
+	/**
+	 * Constructs a new FWindow.
+	 *
+	 * @param title A reference to the title of the window.
+	 * @param width The width of the window.
+	 * @param height The height of the window.
+	 * @param vertices A reference to the vertices of the model.
+	 * @param vertexShaderSource The source of the vertex shader, must outlive the window.
+	 * @param fragmentShaderSource The source of the fragment shader, must outlive the window.
+	 * @param contextGroup A pointer to the context group the window shares its GL objects with, must outlive the window.
+	 * 		The window uses a group of its own if it is <code>nullptr</code>.
+	 */
+	FWindow(const std::string &title, int width, int height, const std::vector<float> &vertices, const char *vertexShaderSource,
+			const char *fragmentShaderSource, FContextGroup *contextGroup = nullptr);
+
+	/**
+	 * Destroys the FWindow.
+	 */
+	virtual ~FWindow();
+
+	/**
+	 * Creates the GLFW window, must be called on the main thread.
+	 *
+	 * @return <code>false</code> if the window could not be created.
+	 */
+	bool createWindow();
+
+	/**
+	 * Destroys the GLFW window, must be called on the main thread after {@link #destroyResources()}.
+	 */
+	void destroyWindow();
+
+	/**
+	 * Creates the GL objects of the window.
+	 *
+	 * <p>The buffer and the program are only created if the context group does not have them yet. The program is built
+	 * asynchronously, the window is drawn without its model until the program is ready. The context of the window is
+	 * current on the calling thread afterwards.</p>
+	 */
+	void createResources();
+
+	/**
+	 * Destroys the GL objects of the window and releases its context from the calling thread.
+	 */
+	void destroyResources();
+
+	/**
+	 * Handles a batch of events recorded by the event pump.
+	 *
+	 * <p>Called on the FThread owning the window.</p>
+	 *
+	 * @param events A reference to the events, the oldest first.
+	 */
+	virtual void handleEvents(const std::vector<FWindowEvent> &events);
+
+	/**
+	 * Updates the window once per tick of the FThread rendering it, before it is drawn.
+	 *
+	 * <p>Windows with animated content request a redraw here, the default implementation does nothing.</p>
+	 *
+	 * @param currentTime The time of the tick in microseconds.
+	 */
+	virtual void update(unsigned long currentTime);
+
+	/**
+	 * Requests the window to be drawn during the next tick of the FThread rendering it.
+	 *
+	 * <p>Must be called on the FThread rendering the window.</p>
+	 */
+	void requestRedraw();
+
+	/**
+	 * Gets whether the content of the window changed since it was drawn the last time.
+	 *
+	 * @return <code>true</code> if the window has to be drawn.
+	 */
+	[[nodiscard]] bool isRedrawRequested() const;
+
+	/**
+	 * Draws the model into the back buffer.
+	 *
+	 * <p>Makes the context of the window current on the calling thread if necessary and clears the redraw request.</p>
+	 */
+	void render();
+
+	/**
+	 * Swaps the front and back buffers of the window.
+	 *
+	 * <p>The context of the window must be current on the calling thread.</p>
+	 *
+	 * @param interval The number of screen updates to wait for, zero to swap immediately.
+	 */
+	void swap(int interval);
+
+	/**
+	 * Gets whether the user requested to close the window.
+	 *
+	 * @return <code>true</code> when the window should be closed.
+	 */
+	[[nodiscard]] bool isCloseRequested() const;
+
+	/**
+	 * Gets the title of the window.
+	 *
+	 * @return a const pointer to the title of the window.
+	 */
+	[[nodiscard]] const std::string *getTitle() const;
+
+	/**
+	 * Gets the GLFW window.
+	 *
+	 * @return a pointer to the GLFW window or <code>nullptr</code> while the window is not created.
+	 */
+	[[nodiscard]] GLFWwindow *getHandle() const;
+
+	/**
+	 * Gets the state of the context of the window, whose counters cover the last drawn frame.
+	 *
+	 * @return a const pointer to the state.
+	 */
+	[[nodiscard]] const FGLState *getGLState() const;
+};
+
+
+#endif /* CORE_CONCURRENT_FWINDOW_HPP_ */
@@ -0,0 +1,127 @@
+/*
+ * BenchmarkCommon.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ *
+ * Code shared by the benchmarks: the JSON result lines, the --quick flag and the shaders of the GL benchmarks.
+ */
+
+#ifndef CORE_CONCURRENT_BENCHMARKCOMMON_HPP_
+#define CORE_CONCURRENT_BENCHMARKCOMMON_HPP_
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+
+typedef std::chrono::steady_clock BenchmarkClock;
+
+/**
+ * Vertex shader passing through the position and the color of the vertices of an {@link FWindow} model.
+ */
+inline const char *vertexShaderSource = R"glsl(
+#version 330
+
+layout (location = 0) in vec2 v_position;
+layout (location = 1) in vec3 v_color;
+
+out vec3 f_color;
+
+void main()
+{
+	gl_Position = vec4(v_position, 1.0, 1.0);
+	f_color = v_color;
+}
+
+)glsl";
+
+/**
+ * Fragment shader writing the interpolated color of the vertices.
+ */
+inline const char *fragmentShaderSource = R"glsl(
+#version 330
+
+layout (location = 0) out vec4 fragmentColor;
+
+in vec3 f_color;
+
+void main()
+{
+	fragmentColor = vec4(f_color, 1.0f);
+}
+
+)glsl";
+
+/**
+ * Whether the benchmarks run for a shorter time, set by --quick.
+ */
+inline bool quickMode = false;
+
+/**
+ * Class collecting the values of one benchmark result and printing them as one JSON line.
+ */
+class BenchmarkResult
+{
+private:
+
+	std::ostringstream m_stream;
+
+public:
+
+	explicit BenchmarkResult(const std::string &benchmark)
+	{
+		this->m_stream << "{\"benchmark\":\"" << benchmark << "\"";
+	}
+
+	BenchmarkResult &add(const std::string &key, const std::string &value)
+	{
+		this->m_stream << ",\"" << key << "\":\"" << value << "\"";
+		return *this;
+	}
+
+	BenchmarkResult &add(const std::string &key, const unsigned long value)
+	{
+		this->m_stream << ",\"" << key << "\":" << value;
+		return *this;
+	}
+
+	BenchmarkResult &add(const std::string &key, const double value)
+	{
+		this->m_stream << ",\"" << key << "\":" << std::fixed << std::setprecision(3) << value;
+		return *this;
+	}
+
+	/**
+	 * Adds the given percentiles and the maximum of the samples, which are sorted in place.
+	 */
+	BenchmarkResult &addPercentiles(const std::string &prefix, std::vector<double> &samples,
+			const std::vector<double> &percentiles = {50.0, 90.0, 99.0})
+	{
+		if (samples.empty())
+			return *this;
+
+		std::sort(samples.begin(), samples.end());
+		for (const double percentile : percentiles)
+		{
+			auto index = static_cast<size_t>(percentile / 100.0 * static_cast<double>(samples.size() - 1));
+			std::ostringstream key;
+			key << prefix << "_p" << percentile;
+			this->add(key.str(), samples[index]);
+		}
+		this->add(prefix + "_max", samples.back());
+		return *this;
+	}
+
+	void print()
+	{
+		std::cout << this->m_stream.str() << "}" << std::endl;
+	}
+};
+
+
+#endif /* CORE_CONCURRENT_BENCHMARKCOMMON_HPP_ */
@@ -0,0 +1,298 @@
+/*
+ * FBatchRendererBenchmark.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ *
+ * Benchmark comparing drawing every object with its own draw call, like the model of an FWindow, with drawing them
+ * through an FBatchRenderer with instanced draw calls per mesh and with one indirect draw call per program. The naive
+ * path runs once with direct GL calls and once through an FGLState filtering redundant binds.
+ *
+ * Every frame moves the given number of objects, split across four meshes and two programs, and draws them into a hidden
+ * window, swapping without waiting for the screen. The draw calls per frame, the CPU time spent submitting a frame and the
+ * time of the whole frame are printed as one JSON object per line, together with the state changes the FGLState issued
+ * and filtered during the last frame. Pass --quick to render fewer frames.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "FBatchRenderer.hpp"
+#include "FWindow.hpp"
+#include "FLogger.hpp"
+#include "GLFW/glfw3.h"
+#include "BenchmarkCommon.hpp"
+
+
+const char *naiveVertexShaderSource = R"glsl(
+#version 330
+
+layout (location = 0) in vec2 v_position;
+layout (location = 1) in vec3 v_color;
+
+uniform vec3 u_transform;
+uniform vec3 u_color;
+
+out vec3 f_color;
+
+void main()
+{
+	gl_Position = vec4(v_position * u_transform.z + u_transform.xy, 1.0, 1.0);
+	f_color = v_color * u_color;
+}
+
+)glsl";
+
+const char *batchVertexShaderSource = R"glsl(
+#version 330
+
+layout (location = 0) in vec2 v_position;
+layout (location = 1) in vec3 v_color;
+layout (location = 2) in vec3 i_transform;
+layout (location = 3) in vec3 i_color;
+
+out vec3 f_color;
+
+void main()
+{
+	gl_Position = vec4(v_position * i_transform.z + i_transform.xy, 1.0, 1.0);
+	f_color = v_color * i_color;
+}
+
+)glsl";
+
+/**
+ * Enum defining how the objects are drawn.
+ */
+enum DrawMode
+{
+	DRAW_NAIVE,
+	DRAW_NAIVE_STATE_CACHE,
+	DRAW_INSTANCED,
+	DRAW_MULTI_DRAW_INDIRECT
+};
+
+/**
+ * Creates the vertices of a regular polygon around the origin with the given number of corners.
+ */
+std::vector<float> createMesh(const unsigned int corners)
+{
+	std::vector<float> vertices;
+	for (unsigned int n = 0; n < corners; n++)
+	{
+		float from = 6.2832f * static_cast<float>(n) / static_cast<float>(corners);
+		float to = 6.2832f * static_cast<float>(n + 1) / static_cast<float>(corners);
+		vertices.insert(vertices.end(), {0.0f, 0.0f, 1.0f, 1.0f, 1.0f});
+		vertices.insert(vertices.end(), {std::cos(from), std::sin(from), 1.0f, 0.5f, 0.0f});
+		vertices.insert(vertices.end(), {std::cos(to), std::sin(to), 0.0f, 0.5f, 1.0f});
+	}
+	return vertices;
+}
+
+/**
+ * Gets the instance data of the given object in the given frame.
+ */
+FInstance createInstance(const unsigned int object, const unsigned long frame)
+{
+	float angle = static_cast<float>(object) * 0.618f + static_cast<float>(frame) * 0.01f;
+	float radius = 0.9f * static_cast<float>(object % 97) / 97.0f;
+	return {radius * std::cos(angle), radius * std::sin(angle), 0.01f, static_cast<float>(object % 7) / 7.0f, 1.0f, 0.5f};
+}
+
+uint32_t createProgram(const char *vertexShaderSource)
+{
+	uint32_t vertexShader = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
+	glCompileShader(vertexShader);
+
+	uint32_t fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
+	glCompileShader(fragmentShader);
+
+	uint32_t program = glCreateProgram();
+	glAttachShader(program, vertexShader);
+	glAttachShader(program, fragmentShader);
+	glLinkProgram(program);
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+	return program;
+}
+
+/**
+ * Draws the given number of moving objects and measures the CPU time and draw calls per frame.
+ */
+void benchmarkDraw(GLFWwindow *window, const std::string &model, const DrawMode mode, const unsigned int objects)
+{
+	const unsigned long frames = quickMode ? 60 : 600;
+	const unsigned int meshCount = 4;
+	const unsigned int programCount = 2;
+
+	std::vector<std::vector<float>> meshes;
+	for (unsigned int n = 0; n < meshCount; n++)
+		meshes.push_back(createMesh(3 + n));
+
+	// the programs are compiled from the same sources, they only differ in their names
+	std::vector<uint32_t> programs;
+	const bool naive = mode == DRAW_NAIVE || mode == DRAW_NAIVE_STATE_CACHE;
+	for (unsigned int n = 0; n < programCount; n++)
+		programs.push_back(createProgram(naive ? naiveVertexShaderSource : batchVertexShaderSource));
+
+	std::vector<Model> models;
+	FGLState glState;
+	FBatchRenderer batchRenderer(objects, mode == DRAW_MULTI_DRAW_INDIRECT, 256, &glState);
+	if (naive)
+	{
+		for (const std::vector<float> &vertices : meshes)
+		{
+			Model mesh = {0, 0, 0};
+			glGenVertexArrays(1, &mesh.vaoId);
+			glBindVertexArray(mesh.vaoId);
+			glGenBuffers(1, &mesh.vboId);
+			glBindBuffer(GL_ARRAY_BUFFER, mesh.vboId);
+			glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(float)), vertices.data(), GL_STATIC_DRAW);
+			glVertexAttribPointer(0, 2, GL_FLOAT, false, sizeof(float) * 5, (const void *) 0);
+			glVertexAttribPointer(1, 3, GL_FLOAT, false, sizeof(float) * 5, (const void *) (sizeof(float) * 2));
+			glEnableVertexAttribArray(0);
+			glEnableVertexAttribArray(1);
+			models.push_back(mesh);
+		}
+		glBindVertexArray(0);
+	}
+	else
+	{
+		if (!batchRenderer.create())
+			return;
+		for (const std::vector<float> &vertices : meshes)
+			batchRenderer.addMesh(vertices);
+	}
+
+	std::vector<GLint> transformLocations;
+	std::vector<GLint> colorLocations;
+	for (const uint32_t program : programs)
+	{
+		transformLocations.push_back(glGetUniformLocation(program, "u_transform"));
+		colorLocations.push_back(glGetUniformLocation(program, "u_color"));
+	}
+
+	unsigned long drawCalls = 0;
+	std::vector<double> cpuTimes;
+	std::vector<double> frameTimes;
+	BenchmarkClock::time_point begin = BenchmarkClock::now();
+	for (unsigned long frame = 0; frame < frames; frame++)
+	{
+		BenchmarkClock::time_point frameBegin = BenchmarkClock::now();
+
+		glClear(GL_COLOR_BUFFER_BIT);
+		drawCalls = 0;
+		for (unsigned int object = 0; object < objects; object++)
+		{
+			// neighbouring objects alternate their meshes and programs, so the naive path cannot skip binds
+			unsigned int mesh = object % meshCount;
+			unsigned int program = (object / 3) % programCount;
+			FInstance instance = createInstance(object, frame);
+			if (mode == DRAW_NAIVE)
+			{
+				glUseProgram(programs[program]);
+				glUniform3f(transformLocations[program], instance.x, instance.y, instance.scale);
+				glUniform3f(colorLocations[program], instance.red, instance.green, instance.blue);
+				glBindVertexArray(models[mesh].vaoId);
+				glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(meshes[mesh].size() / 5));
+				drawCalls++;
+			}
+			else if (mode == DRAW_NAIVE_STATE_CACHE)
+			{
+				glState.useProgram(programs[program]);
+				glUniform3f(transformLocations[program], instance.x, instance.y, instance.scale);
+				glUniform3f(colorLocations[program], instance.red, instance.green, instance.blue);
+				glState.bindVertexArray(models[mesh].vaoId);
+				glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(meshes[mesh].size() / 5));
+				drawCalls++;
+			}
+			else
+			{
+				batchRenderer.draw(programs[program], mesh, instance);
+			}
+		}
+		if (!naive)
+		{
+			batchRenderer.end();
+			drawCalls = batchRenderer.getDrawCalls();
+		}
+		glState.endFrame();
+		cpuTimes.push_back(std::chrono::duration<double, std::micro>(BenchmarkClock::now() - frameBegin).count());
+
+		glfwSwapBuffers(window);
+		frameTimes.push_back(std::chrono::duration<double, std::micro>(BenchmarkClock::now() - frameBegin).count());
+	}
+	glFinish();
+	double seconds = std::chrono::duration<double>(BenchmarkClock::now() - begin).count();
+	bool multiDrawIndirect = batchRenderer.isMultiDrawIndirect();
+
+	glBindVertexArray(0);
+	for (Model &mesh : models)
+	{
+		glDeleteVertexArrays(1, &mesh.vaoId);
+		glDeleteBuffers(1, &mesh.vboId);
+	}
+	batchRenderer.destroy();
+	for (const uint32_t program : programs)
+		glDeleteProgram(program);
+
+	BenchmarkResult("batch_draw")
+			.add("model", model)
+			.add("objects", static_cast<unsigned long>(objects))
+			.add("multi_draw_indirect", std::string(multiDrawIndirect ? "true" : "false"))
+			.add("draw_calls", drawCalls)
+			.add("state_calls_issued", glState.getIssuedCalls())
+			.add("state_calls_filtered", glState.getFilteredCalls())
+			.add("fps", static_cast<double>(frames) / seconds)
+			.addPercentiles("cpu_us", cpuTimes)
+			.addPercentiles("frame_us", frameTimes)
+			.print();
+}
+
+int main(int argc, char **argv)
+{
+	for (int n = 1; n < argc; n++)
+	{
+		if (std::strcmp(argv[n], "--quick") == 0)
+			quickMode = true;
+	}
+
+	// the results on stdout stay one JSON object per line
+	FLogger::setOutput(&std::cerr);
+
+	if (!glfwInit())
+		return -1;
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow *window = glfwCreateWindow(320, 240, "FBatchRendererBenchmark", nullptr, nullptr);
+	if (window == nullptr)
+	{
+		glfwTerminate();
+		return -1;
+	}
+	glfwMakeContextCurrent(window);
+	gladLoadGL();
+	glfwSwapInterval(0);
+
+	for (const unsigned int objects : {1000u, 10000u, 50000u})
+	{
+		benchmarkDraw(window, "naive", DRAW_NAIVE, objects);
+		benchmarkDraw(window, "naive_state_cache", DRAW_NAIVE_STATE_CACHE, objects);
+		benchmarkDraw(window, "instanced", DRAW_INSTANCED, objects);
+		benchmarkDraw(window, "multi_draw_indirect", DRAW_MULTI_DRAW_INDIRECT, objects);
+	}
+
+	glfwDestroyWindow(window);
+	glfwTerminate();
+	return 0;
+}
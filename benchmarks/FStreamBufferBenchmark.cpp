@@ -0,0 +1,214 @@
+/*
+ * FStreamBufferBenchmark.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ *
+ * Benchmark comparing ways to upload vertices that change every frame: glBufferData orphaning the buffer,
+ * glBufferSubData into the same buffer and writing into a persistently mapped FStreamBuffer.
+ *
+ * Every frame moves the given number of triangles, uploads them, draws them into a hidden window and swaps without
+ * waiting for the screen. The time to write and upload the vertices, the time of the whole frame and the number of frames
+ * that waited for the GPU are printed as one JSON object per line. Pass --quick to render fewer frames.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "FStreamBuffer.hpp"
+#include "FLogger.hpp"
+#include "GLFW/glfw3.h"
+#include "BenchmarkCommon.hpp"
+
+
+/**
+ * Enum defining how the vertices are uploaded.
+ */
+enum UploadMode
+{
+	UPLOAD_BUFFER_DATA,
+	UPLOAD_BUFFER_SUB_DATA,
+	UPLOAD_STREAM_BUFFER
+};
+
+/**
+ * Writes the vertices of the given number of small triangles moved to their position in the given frame.
+ */
+void writeTriangles(float *vertices, const unsigned int triangles, const unsigned long frame)
+{
+	static const float SHAPE[3][2] = {{0.0f, 0.01f}, {-0.01f, -0.01f}, {0.01f, -0.01f}};
+	for (unsigned int n = 0; n < triangles; n++)
+	{
+		float angle = static_cast<float>(n) * 0.618f + static_cast<float>(frame) * 0.01f;
+		float radius = 0.9f * static_cast<float>(n % 97) / 97.0f;
+		float x = radius * std::cos(angle);
+		float y = radius * std::sin(angle);
+		for (const auto &corner : SHAPE)
+		{
+			*vertices++ = x + corner[0];
+			*vertices++ = y + corner[1];
+			*vertices++ = 1.0f;
+			*vertices++ = static_cast<float>(n % 7) / 7.0f;
+			*vertices++ = 0.5f;
+		}
+	}
+}
+
+uint32_t createProgram()
+{
+	uint32_t vertexShader = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
+	glCompileShader(vertexShader);
+
+	uint32_t fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
+	glCompileShader(fragmentShader);
+
+	uint32_t program = glCreateProgram();
+	glAttachShader(program, vertexShader);
+	glAttachShader(program, fragmentShader);
+	glLinkProgram(program);
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+	return program;
+}
+
+/**
+ * Renders the given number of moving triangles and measures how long uploading their vertices takes.
+ */
+void benchmarkUpload(GLFWwindow *window, const std::string &model, const UploadMode mode, const unsigned int triangles)
+{
+	const unsigned long frames = quickMode ? 60 : 600;
+	const size_t vertexSize = sizeof(float) * 5;
+	const size_t size = vertexSize * 3 * triangles;
+
+	uint32_t program = createProgram();
+	uint32_t vao;
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+
+	uint32_t buffer = 0;
+	std::vector<float> vertices;
+	FStreamBuffer streamBuffer(GL_ARRAY_BUFFER, size);
+	if (mode == UPLOAD_STREAM_BUFFER)
+	{
+		if (!streamBuffer.create())
+			return;
+		buffer = streamBuffer.getBuffer();
+	}
+	else
+	{
+		vertices.resize(size / sizeof(float));
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	glUseProgram(program);
+
+	std::vector<double> uploadTimes;
+	std::vector<double> frameTimes;
+	BenchmarkClock::time_point begin = BenchmarkClock::now();
+	for (unsigned long frame = 0; frame < frames; frame++)
+	{
+		BenchmarkClock::time_point frameBegin = BenchmarkClock::now();
+
+		size_t offset = 0;
+		if (mode == UPLOAD_STREAM_BUFFER)
+		{
+			streamBuffer.beginFrame();
+			writeTriangles(static_cast<float *>(streamBuffer.allocate(size, vertexSize, offset)), triangles, frame);
+			streamBuffer.flush();
+			// without OpenGL 4.4 the stream buffer maps and unmaps its region with the buffer bound and unbinds it afterwards
+			if (!streamBuffer.isPersistent())
+				glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		}
+		else
+		{
+			writeTriangles(vertices.data(), triangles, frame);
+			if (mode == UPLOAD_BUFFER_DATA)
+				glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), vertices.data(), GL_STREAM_DRAW);
+			else
+				glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(size), vertices.data());
+		}
+		uploadTimes.push_back(std::chrono::duration<double, std::micro>(BenchmarkClock::now() - frameBegin).count());
+
+		glVertexAttribPointer(0, 2, GL_FLOAT, false, vertexSize, reinterpret_cast<const void *>(offset));
+		glVertexAttribPointer(1, 3, GL_FLOAT, false, vertexSize, reinterpret_cast<const void *>(offset + sizeof(float) * 2));
+		glClear(GL_COLOR_BUFFER_BIT);
+		glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(3 * triangles));
+
+		if (mode == UPLOAD_STREAM_BUFFER)
+			streamBuffer.endFrame();
+		glfwSwapBuffers(window);
+
+		frameTimes.push_back(std::chrono::duration<double, std::micro>(BenchmarkClock::now() - frameBegin).count());
+	}
+	glFinish();
+	double seconds = std::chrono::duration<double>(BenchmarkClock::now() - begin).count();
+	bool persistent = streamBuffer.isPersistent();
+
+	if (mode == UPLOAD_STREAM_BUFFER)
+		streamBuffer.destroy();
+	else
+		glDeleteBuffers(1, &buffer);
+	glDeleteVertexArrays(1, &vao);
+	glDeleteProgram(program);
+
+	BenchmarkResult("stream_upload")
+			.add("model", model)
+			.add("triangles", static_cast<unsigned long>(triangles))
+			.add("persistent", std::string(persistent ? "true" : "false"))
+			.add("fps", static_cast<double>(frames) / seconds)
+			.add("stalls", streamBuffer.getStalls())
+			.addPercentiles("upload_us", uploadTimes)
+			.addPercentiles("frame_us", frameTimes)
+			.print();
+}
+
+int main(int argc, char **argv)
+{
+	for (int n = 1; n < argc; n++)
+	{
+		if (std::strcmp(argv[n], "--quick") == 0)
+			quickMode = true;
+	}
+
+	// the results on stdout stay one JSON object per line
+	FLogger::setOutput(&std::cerr);
+
+	if (!glfwInit())
+		return -1;
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow *window = glfwCreateWindow(320, 240, "FStreamBufferBenchmark", nullptr, nullptr);
+	if (window == nullptr)
+	{
+		glfwTerminate();
+		return -1;
+	}
+	glfwMakeContextCurrent(window);
+	gladLoadGL();
+	glfwSwapInterval(0);
+
+	for (const unsigned int triangles : {1000u, 10000u, 100000u})
+	{
+		benchmarkUpload(window, "buffer_data", UPLOAD_BUFFER_DATA, triangles);
+		benchmarkUpload(window, "buffer_sub_data", UPLOAD_BUFFER_SUB_DATA, triangles);
+		benchmarkUpload(window, "stream_buffer", UPLOAD_STREAM_BUFFER, triangles);
+	}
+
+	glfwDestroyWindow(window);
+	glfwTerminate();
+	return 0;
+}
@@ -0,0 +1,638 @@
+/*
+ * FThreadBenchmark.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ *
+ * Microbenchmarks for the task queue, wakeup and pacing paths of FThread.
+ *
+ * Every result is printed as one JSON object per line, so the output can be collected and compared over time.
+ * Pass --quick to run with reduced iteration counts.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "FThread.hpp"
+#include "FChannel.hpp"
+#include "FTickHost.hpp"
+#include "BenchmarkCommon.hpp"
+
+
+/**
+ * The percentiles reported for latencies and jitter, whose rare outliers matter more than those of frame times.
+ */
+const std::vector<double> PERCENTILES = {50.0, 90.0, 99.0, 99.9};
+
+/**
+ * Counter of the hardware cache misses of the process and every thread it creates afterwards.
+ *
+ * <p>Reports -1 when hardware counters are not available, e.g. on other platforms than Linux or in containers.</p>
+ */
+class CacheMissCounter
+{
+private:
+
+	int m_fd;
+
+public:
+
+	CacheMissCounter()
+	{
+		this->m_fd = -1;
+#ifdef __linux__
+		perf_event_attr attributes{};
+		attributes.type = PERF_TYPE_HARDWARE;
+		attributes.size = sizeof(perf_event_attr);
+		attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+		attributes.disabled = 1;
+		attributes.inherit = 1;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		this->m_fd = static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+		if (this->m_fd >= 0)
+		{
+			ioctl(this->m_fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(this->m_fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+	}
+
+	~CacheMissCounter()
+	{
+#ifdef __linux__
+		if (this->m_fd >= 0)
+			close(this->m_fd);
+#endif
+	}
+
+	/**
+	 * Stops counting and gets the number of cache misses.
+	 */
+	long stop()
+	{
+#ifdef __linux__
+		long long count = 0;
+		if (this->m_fd >= 0)
+		{
+			ioctl(this->m_fd, PERF_EVENT_IOC_DISABLE, 0);
+			if (read(this->m_fd, &count, sizeof(count)) == sizeof(count))
+				return static_cast<long>(count);
+		}
+#endif
+		return -1;
+	}
+};
+
+/**
+ * FThread which does nothing but executing its tasks and optionally recording its tick times.
+ */
+class BenchmarkThread : public FThread
+{
+public:
+
+	/**
+	 * The time points of the recorded ticks.
+	 */
+	std::vector<BenchmarkClock::time_point> tickTimes;
+	/**
+	 * The number of ticks that will be recorded before the thread stops itself. Zero disables recording.
+	 */
+	unsigned long recordTicks;
+	/**
+	 * The time point at which {@link #onStart()} was entered.
+	 */
+	std::atomic<BenchmarkClock::rep> startedAt;
+
+	explicit BenchmarkThread(double ticksPerSecond, const TaskQueueMode &taskQueueMode = QUEUE_ENABLED, unsigned long recordTicks = 0)
+			: FThread("BenchmarkThread", ticksPerSecond, taskQueueMode, 1u << 30u)
+	{
+		this->recordTicks = recordTicks;
+		this->tickTimes.reserve(recordTicks);
+		this->startedAt = 0;
+	}
+
+	void onStart() override
+	{
+		this->startedAt = BenchmarkClock::now().time_since_epoch().count();
+	}
+
+	void onTick(const unsigned long currentTime, const unsigned long currentTick) override
+	{
+		if (this->recordTicks == 0)
+			return;
+
+		this->tickTimes.push_back(BenchmarkClock::now());
+		if (this->tickTimes.size() >= this->recordTicks)
+			this->stop();
+	}
+
+	void onStop() override
+	{
+	}
+
+	/**
+	 * Blocks until the thread accepts tasks.
+	 */
+	void waitUntilRunning() const
+	{
+		while (!this->isRunning())
+			std::this_thread::yield();
+	}
+};
+
+const char *getModeName(const TaskQueueMode mode)
+{
+	switch (mode)
+	{
+		case QUEUE_ENABLED:
+			return "QUEUE_ENABLED";
+		case QUEUE_ONLY:
+			return "QUEUE_ONLY";
+		default:
+			return "QUEUE_DISABLED";
+	}
+}
+
+double toMicroseconds(const BenchmarkClock::duration &duration)
+{
+	return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+/**
+ * Measures how many tasks per second a no-sleep QUEUE_ONLY thread accepts and executes with the given number of producers.
+ */
+void benchmarkAddTaskThroughput(const unsigned int producers)
+{
+	const unsigned long tasksPerProducer = (quickMode ? 20000 : 200000) / producers;
+	const unsigned long totalTasks = tasksPerProducer * producers;
+
+	BenchmarkThread consumer(-1.0, QUEUE_ONLY);
+	std::thread *consumerThread = consumer.start();
+	consumer.waitUntilRunning();
+
+	std::atomic_ulong executed(0);
+	std::atomic_bool go(false);
+	std::vector<std::thread> producerThreads;
+	std::vector<double> addTaskTimes(producers);
+	for (unsigned int n = 0; n < producers; n++)
+	{
+		producerThreads.emplace_back([&, n] {
+			while (!go)
+				std::this_thread::yield();
+
+			BenchmarkClock::time_point begin = BenchmarkClock::now();
+			for (unsigned long i = 0; i < tasksPerProducer; i++)
+				consumer.addTask([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+			addTaskTimes[n] = toMicroseconds(BenchmarkClock::now() - begin) * 1000.0 / static_cast<double>(tasksPerProducer);
+		});
+	}
+
+	BenchmarkClock::time_point begin = BenchmarkClock::now();
+	go = true;
+	for (std::thread &thread : producerThreads)
+		thread.join();
+	while (executed < totalTasks)
+		std::this_thread::yield();
+	BenchmarkClock::duration duration = BenchmarkClock::now() - begin;
+
+	consumer.stop();
+	consumerThread->join();
+	delete consumerThread;
+
+	double seconds = toMicroseconds(duration) / 1000000.0;
+	BenchmarkResult("addtask_throughput")
+			.add("producers", static_cast<unsigned long>(producers))
+			.add("tasks", totalTasks)
+			.add("tasks_per_second", static_cast<double>(totalTasks) / seconds)
+			.add("addtask_ns_avg", std::accumulate(addTaskTimes.begin(), addTaskTimes.end(), 0.0) / producers)
+			.print();
+}
+
+/**
+ * Measures the cost of tasks an FThread adds to itself and executes in the following pass.
+ */
+void benchmarkSelfAddTask()
+{
+	const unsigned long tasks = quickMode ? 100000 : 1000000;
+
+	BenchmarkThread thread(-1.0, QUEUE_ENABLED);
+	std::thread *stdThread = thread.start();
+	thread.waitUntilRunning();
+
+	std::atomic<double> addTaskNanoseconds(0.0);
+	std::atomic_ulong executed(0);
+	BenchmarkClock::time_point begin = BenchmarkClock::now();
+	thread.addTask([&] {
+		unsigned long *counter = new unsigned long(0);
+		BenchmarkClock::time_point addBegin = BenchmarkClock::now();
+		for (unsigned long n = 0; n < tasks; n++)
+		{
+			thread.addTask([counter, &executed, tasks] {
+				if (++*counter == tasks)
+				{
+					delete counter;
+					executed = tasks;
+				}
+			});
+		}
+		addTaskNanoseconds = toMicroseconds(BenchmarkClock::now() - addBegin) * 1000.0 / static_cast<double>(tasks);
+	});
+	while (executed < tasks)
+		std::this_thread::yield();
+	BenchmarkClock::duration duration = BenchmarkClock::now() - begin;
+
+	thread.stop();
+	stdThread->join();
+	delete stdThread;
+
+	BenchmarkResult("addtask_self")
+			.add("tasks", tasks)
+			.add("tasks_per_second", static_cast<double>(tasks) * 1000000.0 / toMicroseconds(duration))
+			.add("addtask_ns_avg", addTaskNanoseconds.load())
+			.print();
+}
+
+/**
+ * Measures how many messages per second a no-sleep QUEUE_ONLY thread drains from a channel with the given number of
+ * producers, for comparison with {@link #benchmarkAddTaskThroughput()}.
+ */
+template<typename Channel>
+void benchmarkChannelThroughput(const std::string &channelName, const unsigned int producers, const size_t batchSize)
+{
+	const unsigned long messagesPerProducer = (quickMode ? 200000 : 2000000) / producers;
+	const unsigned long totalMessages = messagesPerProducer * producers;
+
+	BenchmarkThread consumer(-1.0, QUEUE_ONLY);
+	Channel channel(4096);
+	std::atomic_ulong received(0);
+	channel.connect(&consumer, [&received] (unsigned long *messages, size_t count) {
+		unsigned long sum = 0;
+		for (size_t n = 0; n < count; n++)
+			sum += messages[n];
+		if (sum != 0)
+			received.fetch_add(count, std::memory_order_relaxed);
+	}, true);
+
+	std::thread *consumerThread = consumer.start();
+	consumer.waitUntilRunning();
+
+	std::atomic_bool go(false);
+	std::vector<std::thread> producerThreads;
+	for (unsigned int n = 0; n < producers; n++)
+	{
+		producerThreads.emplace_back([&] {
+			std::vector<unsigned long> batch(batchSize, 1);
+			while (!go)
+				std::this_thread::yield();
+
+			unsigned long pushed = 0;
+			while (pushed < messagesPerProducer)
+			{
+				size_t count = std::min<unsigned long>(batchSize, messagesPerProducer - pushed);
+				size_t accepted = batchSize == 1 ? channel.push(1) : channel.pushBatch(batch.data(), count);
+				if (accepted == 0)
+					std::this_thread::yield();
+				pushed += accepted;
+			}
+		});
+	}
+
+	BenchmarkClock::time_point begin = BenchmarkClock::now();
+	go = true;
+	for (std::thread &thread : producerThreads)
+		thread.join();
+	while (received < totalMessages)
+		std::this_thread::yield();
+	BenchmarkClock::duration duration = BenchmarkClock::now() - begin;
+
+	consumer.stop();
+	consumerThread->join();
+	delete consumerThread;
+
+	BenchmarkResult("channel_throughput")
+			.add("channel", channelName)
+			.add("producers", static_cast<unsigned long>(producers))
+			.add("batch", static_cast<unsigned long>(batchSize))
+			.add("messages", totalMessages)
+			.add("messages_per_second", static_cast<double>(totalMessages) * 1000000.0 / toMicroseconds(duration))
+			.print();
+}
+
+/**
+ * Measures cache misses while producers add tasks to and observers poll the state of a busy ticking FThread.
+ *
+ * <p>The FThread writes its tick count and time every tick, the producers write the task queue and the observers read
+ * the running flag and tick count, so every access pattern of FThread runs at the same time.</p>
+ */
+void benchmarkContention(const unsigned int producers, const unsigned int observers)
+{
+	const unsigned long tasksPerProducer = quickMode ? 100000 : 1000000;
+	const unsigned long totalTasks = tasksPerProducer * producers;
+
+	CacheMissCounter cacheMisses;
+	BenchmarkThread consumer(-1.0, QUEUE_ENABLED);
+	std::thread *consumerThread = consumer.start();
+	consumer.waitUntilRunning();
+
+	std::atomic_ulong executed(0);
+	std::atomic_bool go(false);
+	std::atomic_bool done(false);
+	std::atomic_ulong observations(0);
+	std::vector<std::thread> threads;
+	for (unsigned int n = 0; n < observers; n++)
+	{
+		threads.emplace_back([&] {
+			unsigned long count = 0;
+			unsigned long lastTick = 0;
+			while (!done)
+			{
+				if (consumer.isRunning() && consumer.getTickCount() != lastTick)
+					lastTick = consumer.getTickCount();
+				count++;
+			}
+			observations += count;
+		});
+	}
+
+	std::vector<std::thread> producerThreads;
+	for (unsigned int n = 0; n < producers; n++)
+	{
+		producerThreads.emplace_back([&] {
+			while (!go)
+				std::this_thread::yield();
+
+			for (unsigned long i = 0; i < tasksPerProducer; i++)
+				consumer.addTask([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+		});
+	}
+
+	BenchmarkClock::time_point begin = BenchmarkClock::now();
+	go = true;
+	for (std::thread &thread : producerThreads)
+		thread.join();
+	while (executed < totalTasks)
+		std::this_thread::yield();
+	BenchmarkClock::duration duration = BenchmarkClock::now() - begin;
+
+	done = true;
+	for (std::thread &thread : threads)
+		thread.join();
+	consumer.stop();
+	consumerThread->join();
+	delete consumerThread;
+	long misses = cacheMisses.stop();
+
+	BenchmarkResult("contention")
+			.add("producers", static_cast<unsigned long>(producers))
+			.add("observers", static_cast<unsigned long>(observers))
+			.add("tasks_per_second", static_cast<double>(totalTasks) * 1000000.0 / toMicroseconds(duration))
+			.add("observations_per_second", static_cast<double>(observations) * 1000000.0 / toMicroseconds(duration))
+			.add("cache_misses", static_cast<double>(misses))
+			.add("cache_misses_per_task", misses < 0 ? -1.0 : static_cast<double>(misses) / static_cast<double>(totalTasks))
+			.print();
+}
+
+/**
+ * Measures the time between addTask() and the execution of the task for the given task queue mode.
+ */
+void benchmarkTaskLatency(const TaskQueueMode mode, const double ticksPerSecond)
+{
+	const unsigned long samples = quickMode ? 500 : 5000;
+
+	BenchmarkThread consumer(ticksPerSecond, mode);
+	std::thread *consumerThread = consumer.start();
+	consumer.waitUntilRunning();
+
+	std::vector<double> latencies;
+	latencies.reserve(samples);
+	std::atomic_ulong executed(0);
+
+	BenchmarkClock::duration addTaskDuration(0);
+	BenchmarkClock::time_point begin = BenchmarkClock::now();
+	for (unsigned long n = 0; n < samples; n++)
+	{
+		BenchmarkClock::time_point enqueuedAt = BenchmarkClock::now();
+		consumer.addTask([&latencies, &executed, enqueuedAt] {
+			latencies.push_back(toMicroseconds(BenchmarkClock::now() - enqueuedAt));
+			executed.fetch_add(1, std::memory_order_release);
+		});
+		addTaskDuration += BenchmarkClock::now() - enqueuedAt;
+
+		// spread the samples over the tick period instead of posting them all at once
+		std::this_thread::sleep_until(begin + std::chrono::microseconds(97 * (n + 1)));
+	}
+
+	if (mode != QUEUE_DISABLED)
+	{
+		while (executed.load(std::memory_order_acquire) < samples)
+			std::this_thread::yield();
+	}
+
+	consumer.stop();
+	consumerThread->join();
+	delete consumerThread;
+
+	BenchmarkResult("task_latency")
+			.add("mode", getModeName(mode))
+			.add("tps", ticksPerSecond)
+			.add("samples", static_cast<unsigned long>(latencies.size()))
+			.add("addtask_ns_avg", toMicroseconds(addTaskDuration) * 1000.0 / static_cast<double>(samples))
+			.addPercentiles("latency_us", latencies, PERCENTILES)
+			.print();
+}
+
+/**
+ * Measures how far the tick intervals of an FThread deviate from the ideal interval.
+ */
+void benchmarkTickJitter(const double ticksPerSecond)
+{
+	const auto ticks = static_cast<unsigned long>(ticksPerSecond * (quickMode ? 0.5 : 3.0));
+
+	BenchmarkThread thread(ticksPerSecond, QUEUE_ENABLED, ticks);
+	std::thread *stdThread = thread.start();
+	stdThread->join();
+	delete stdThread;
+
+	const double idealInterval = 1000000.0 / ticksPerSecond;
+	std::vector<double> jitter;
+	jitter.reserve(thread.tickTimes.size());
+	for (size_t n = 1; n < thread.tickTimes.size(); n++)
+		jitter.push_back(std::abs(toMicroseconds(thread.tickTimes[n] - thread.tickTimes[n - 1]) - idealInterval));
+
+	const double elapsed = toMicroseconds(thread.tickTimes.back() - thread.tickTimes.front());
+	BenchmarkResult("tick_jitter")
+			.add("tps", ticksPerSecond)
+			.add("ticks", static_cast<unsigned long>(thread.tickTimes.size()))
+			.add("achieved_tps", static_cast<double>(thread.tickTimes.size() - 1) * 1000000.0 / elapsed)
+			.addPercentiles("jitter_us", jitter, PERCENTILES)
+			.print();
+}
+
+/**
+ * FTicker recording the time points of its ticks.
+ */
+class BenchmarkTicker : public FTicker
+{
+public:
+
+	/**
+	 * The time points of the recorded ticks.
+	 */
+	std::vector<BenchmarkClock::time_point> tickTimes;
+
+	BenchmarkTicker(double ticksPerSecond, size_t expectedTicks) : FTicker("BenchmarkTicker", ticksPerSecond)
+	{
+		this->tickTimes.reserve(expectedTicks);
+	}
+
+	void onStart() override
+	{
+	}
+
+	void onTick(const unsigned long currentTime, const unsigned long currentTick) override
+	{
+		this->tickTimes.push_back(BenchmarkClock::now());
+	}
+
+	void onStop() override
+	{
+	}
+};
+
+/**
+ * Measures how far the tick intervals of FTickers deviate from the ideal interval when many of them share a few workers.
+ */
+void benchmarkTickHost(const unsigned int tickers, const unsigned int workers, const double ticksPerSecond)
+{
+	const std::chrono::milliseconds duration(quickMode ? 300 : 2000);
+	const auto expectedTicks = static_cast<size_t>(ticksPerSecond * std::chrono::duration<double>(duration).count());
+
+	FTickHost host("BenchmarkHost", workers);
+	std::vector<BenchmarkTicker *> benchmarkTickers;
+	for (unsigned int n = 0; n < tickers; n++)
+	{
+		benchmarkTickers.push_back(new BenchmarkTicker(ticksPerSecond, expectedTicks + 16));
+		host.addTicker(benchmarkTickers.back());
+	}
+
+	host.start();
+	std::this_thread::sleep_for(duration);
+	host.stop();
+
+	const double idealInterval = 1000000.0 / ticksPerSecond;
+	std::vector<double> jitter;
+	unsigned long ticks = 0;
+	BenchmarkClock::time_point firstTick = BenchmarkClock::time_point::max();
+	BenchmarkClock::time_point lastTick = BenchmarkClock::time_point::min();
+	for (BenchmarkTicker *ticker : benchmarkTickers)
+	{
+		ticks += ticker->tickTimes.size();
+		if (!ticker->tickTimes.empty())
+		{
+			firstTick = std::min(firstTick, ticker->tickTimes.front());
+			lastTick = std::max(lastTick, ticker->tickTimes.back());
+		}
+		for (size_t n = 1; n < ticker->tickTimes.size(); n++)
+			jitter.push_back(std::abs(toMicroseconds(ticker->tickTimes[n] - ticker->tickTimes[n - 1]) - idealInterval));
+		delete ticker;
+	}
+
+	// the first tick of every FTicker happens right away, so only the intervals after it count like in tick_jitter
+	const double elapsed = ticks > tickers ? toMicroseconds(lastTick - firstTick) : 0.0;
+	BenchmarkResult("tick_host")
+			.add("tickers", static_cast<unsigned long>(tickers))
+			.add("workers", static_cast<unsigned long>(workers))
+			.add("tps", ticksPerSecond)
+			.add("ticks", ticks)
+			.add("achieved_tps", elapsed > 0.0 ? static_cast<double>(ticks - tickers) / tickers * 1000000.0 / elapsed : 0.0)
+			.addPercentiles("jitter_us", jitter, PERCENTILES)
+			.print();
+}
+
+/**
+ * Measures how long it takes until a started FThread enters onStart() and until a stopped FThread has finished.
+ */
+void benchmarkStartStop(const double ticksPerSecond)
+{
+	const unsigned int iterations = quickMode ? 50 : 500;
+
+	std::vector<double> startTimes;
+	std::vector<double> stopTimes;
+	for (unsigned int n = 0; n < iterations; n++)
+	{
+		BenchmarkThread thread(ticksPerSecond);
+
+		BenchmarkClock::time_point begin = BenchmarkClock::now();
+		std::thread *stdThread = thread.start();
+		thread.waitUntilRunning();
+		startTimes.push_back(toMicroseconds(BenchmarkClock::duration(thread.startedAt.load()) - begin.time_since_epoch()));
+
+		begin = BenchmarkClock::now();
+		thread.stop();
+		stdThread->join();
+		stopTimes.push_back(toMicroseconds(BenchmarkClock::now() - begin));
+		delete stdThread;
+	}
+
+	BenchmarkResult("start_stop")
+			.add("tps", ticksPerSecond)
+			.add("iterations", static_cast<unsigned long>(iterations))
+			.addPercentiles("start_us", startTimes, PERCENTILES)
+			.addPercentiles("stop_us", stopTimes, PERCENTILES)
+			.print();
+}
+
+int main(int argc, char **argv)
+{
+	for (int n = 1; n < argc; n++)
+	{
+		if (std::strcmp(argv[n], "--quick") == 0)
+			quickMode = true;
+	}
+
+	for (const unsigned int producers : {1u, 2u, 4u, 8u, 16u, 32u, 64u})
+		benchmarkAddTaskThroughput(producers);
+
+	benchmarkSelfAddTask();
+
+	for (const size_t batchSize : {static_cast<size_t>(1), static_cast<size_t>(32)})
+	{
+		benchmarkChannelThroughput<FSPSCChannel<unsigned long>>("spsc", 1, batchSize);
+		for (const unsigned int producers : {1u, 4u, 16u})
+			benchmarkChannelThroughput<FMPMCChannel<unsigned long>>("mpmc", producers, batchSize);
+	}
+
+	benchmarkContention(2, 2);
+	benchmarkContention(4, 4);
+
+	benchmarkTaskLatency(QUEUE_ENABLED, 1000.0);
+	benchmarkTaskLatency(QUEUE_ONLY, -1.0);
+	benchmarkTaskLatency(QUEUE_DISABLED, 1000.0);
+
+	for (const double ticksPerSecond : {60.0, 144.0, 1000.0})
+		benchmarkTickJitter(ticksPerSecond);
+
+	for (const unsigned int tickers : {16u, 256u})
+	{
+		benchmarkTickHost(tickers, 1, 60.0);
+		benchmarkTickHost(tickers, 4, 60.0);
+	}
+
+	benchmarkStartStop(60.0);
+	benchmarkStartStop(-1.0);
+
+	return 0;
+}
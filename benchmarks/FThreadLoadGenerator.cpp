@@ -0,0 +1,524 @@
+/*
+ * FThreadLoadGenerator.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ *
+ * Load generator for soak-testing FThread under production-like traffic.
+ *
+ * M producer FThreads post tasks to N consumer FThreads following a script of rate phases with optional bursts.
+ * Every task burns CPU for a duration drawn from a configurable cost distribution. Throughput, enqueue-to-execute
+ * latency percentiles, queue depth and resident memory are printed as one JSON object per report interval.
+ *
+ * Example:
+ *   FThreadLoadGenerator --producers 8 --consumers 4 --duration 7200 --phase 60:2000 --phase 30:20000
+ *                        --burst 1000:100:5 --cost exponential:20 --slow 0.001:5000
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <cstring>
+#include <cmath>
+#include <memory>
+
+#include "FThread.hpp"
+#include "FLogger.hpp"
+
+
+typedef std::chrono::steady_clock LoadClock;
+
+/**
+ * Enum defining how the cost of a task is distributed.
+ */
+enum CostDistribution
+{
+	COST_FIXED,
+	COST_UNIFORM,
+	COST_EXPONENTIAL,
+	COST_PARETO
+};
+
+/**
+ * One phase of the rate script.
+ */
+struct RatePhase
+{
+	/**
+	 * The duration of the phase in seconds.
+	 */
+	double duration;
+	/**
+	 * The number of tasks every producer posts per second during the phase.
+	 */
+	double rate;
+};
+
+/**
+ * The configuration of the load generator.
+ */
+struct LoadConfig
+{
+	unsigned int producers = 4;
+	unsigned int consumers = 2;
+	double producerTps = 1000.0;
+	double consumerTps = 1000.0;
+	TaskQueueMode consumerMode = QUEUE_ENABLED;
+	double duration = 60.0;
+	double reportInterval = 1.0;
+	std::vector<RatePhase> phases;
+	double burstPeriod = 0.0;
+	double burstLength = 0.0;
+	double burstFactor = 1.0;
+	CostDistribution costDistribution = COST_FIXED;
+	double costMean = 10.0;
+	double slowFraction = 0.0;
+	double slowCost = 0.0;
+};
+
+/**
+ * Latency histogram with logarithmic buckets that is written by a single thread and read by the reporter.
+ *
+ * <p>Every power of two is split into four sub buckets, so the reported percentiles are accurate to about 20%.</p>
+ */
+class LatencyHistogram
+{
+public:
+
+	static constexpr unsigned int BUCKETS = 4 * 40;
+
+private:
+
+	std::atomic_ulong m_buckets[BUCKETS];
+
+	static unsigned int getBucket(const unsigned long nanoseconds)
+	{
+		if (nanoseconds < 4)
+			return static_cast<unsigned int>(nanoseconds);
+
+		auto exponent = static_cast<unsigned int>(63 - __builtin_clzl(nanoseconds));
+		auto subBucket = static_cast<unsigned int>((nanoseconds >> (exponent - 2)) & 3u);
+		return std::min(exponent * 4 + subBucket, BUCKETS - 1);
+	}
+
+	static double getBucketValue(const unsigned int bucket)
+	{
+		if (bucket < 4)
+			return bucket;
+
+		unsigned int exponent = bucket / 4;
+		unsigned int subBucket = bucket % 4;
+		return std::ldexp(1.0 + subBucket / 4.0, static_cast<int>(exponent));
+	}
+
+public:
+
+	LatencyHistogram()
+	{
+		for (std::atomic_ulong &bucket : this->m_buckets)
+			bucket = 0;
+	}
+
+	/**
+	 * Records a latency. Must only be called by the owning thread.
+	 */
+	void record(const unsigned long nanoseconds)
+	{
+		std::atomic_ulong &bucket = this->m_buckets[getBucket(nanoseconds)];
+		bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Adds the current counts of this histogram to the given counts.
+	 */
+	void collect(std::vector<unsigned long> &counts) const
+	{
+		counts.resize(BUCKETS);
+		for (unsigned int n = 0; n < BUCKETS; n++)
+			counts[n] += this->m_buckets[n].load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Gets the given percentile in microseconds of the difference of two collected count snapshots.
+	 */
+	static double getPercentile(const std::vector<unsigned long> &current, const std::vector<unsigned long> &previous, const double percentile)
+	{
+		unsigned long total = 0;
+		for (unsigned int n = 0; n < BUCKETS; n++)
+			total += current[n] - previous[n];
+		if (total == 0)
+			return 0.0;
+
+		auto target = static_cast<unsigned long>(std::ceil(percentile / 100.0 * static_cast<double>(total)));
+		unsigned long seen = 0;
+		for (unsigned int n = 0; n < BUCKETS; n++)
+		{
+			seen += current[n] - previous[n];
+			if (seen >= target)
+				return getBucketValue(n) / 1000.0;
+		}
+
+		return getBucketValue(BUCKETS - 1) / 1000.0;
+	}
+};
+
+/**
+ * FThread executing the generated tasks.
+ */
+class ConsumerThread : public FThread
+{
+public:
+
+	LatencyHistogram latencies;
+	std::atomic_ulong submitted;
+	std::atomic_ulong executed;
+
+	ConsumerThread(const std::string &name, const LoadConfig &config)
+			: FThread(name, config.consumerTps, config.consumerMode, 1u << 20u)
+	{
+		this->submitted = 0;
+		this->executed = 0;
+	}
+
+	void onStart() override
+	{
+	}
+
+	void onTick(const unsigned long currentTime, const unsigned long currentTick) override
+	{
+	}
+
+	void onStop() override
+	{
+	}
+
+	/**
+	 * Posts a task that burns the given amount of CPU time.
+	 */
+	void post(const unsigned long costNanoseconds)
+	{
+		LoadClock::time_point enqueuedAt = LoadClock::now();
+		// counted up front so the task cannot be executed before it was submitted
+		this->submitted.fetch_add(1, std::memory_order_relaxed);
+		bool accepted = this->addTask([this, enqueuedAt, costNanoseconds] {
+			LoadClock::time_point startedAt = LoadClock::now();
+			this->latencies.record(std::chrono::duration_cast<std::chrono::nanoseconds>(startedAt - enqueuedAt).count());
+
+			LoadClock::time_point busyUntil = startedAt + std::chrono::nanoseconds(costNanoseconds);
+			while (LoadClock::now() < busyUntil)
+			{
+			}
+
+			this->executed.fetch_add(1, std::memory_order_relaxed);
+		});
+
+		// a consumer drops tasks until it is running, those would count as queued for the whole run
+		if (!accepted)
+			this->submitted.fetch_sub(1, std::memory_order_relaxed);
+	}
+};
+
+/**
+ * FThread posting tasks to the consumers according to the rate script.
+ */
+class ProducerThread : public FThread
+{
+private:
+
+	const LoadConfig &m_config;
+	std::vector<ConsumerThread *> &m_consumers;
+	std::mt19937_64 m_random;
+	LoadClock::time_point m_begin;
+	LoadClock::time_point m_lastTick;
+	double m_pendingTasks;
+	unsigned int m_nextConsumer;
+
+	[[nodiscard]] double getRate(const double elapsed) const
+	{
+		double scriptDuration = 0.0;
+		for (const RatePhase &phase : this->m_config.phases)
+			scriptDuration += phase.duration;
+
+		double time = std::fmod(elapsed, scriptDuration);
+		double rate = this->m_config.phases.back().rate;
+		for (const RatePhase &phase : this->m_config.phases)
+		{
+			if (time < phase.duration)
+			{
+				rate = phase.rate;
+				break;
+			}
+			time -= phase.duration;
+		}
+
+		if (this->m_config.burstPeriod > 0.0 && std::fmod(elapsed, this->m_config.burstPeriod) < this->m_config.burstLength)
+			rate *= this->m_config.burstFactor;
+
+		return rate;
+	}
+
+	unsigned long sampleCost()
+	{
+		double mean = this->m_config.costMean;
+		double cost;
+		switch (this->m_config.costDistribution)
+		{
+			case COST_UNIFORM:
+				cost = std::uniform_real_distribution<double>(0.0, 2.0 * mean)(this->m_random);
+				break;
+			case COST_EXPONENTIAL:
+				cost = std::exponential_distribution<double>(1.0 / mean)(this->m_random);
+				break;
+			case COST_PARETO:
+			{
+				// pareto with alpha 2 has a mean of twice its minimum
+				double uniform = std::uniform_real_distribution<double>(0.0, 1.0)(this->m_random);
+				cost = mean / 2.0 / std::sqrt(1.0 - uniform);
+				break;
+			}
+			default:
+				cost = mean;
+				break;
+		}
+
+		if (this->m_config.slowFraction > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(this->m_random) < this->m_config.slowFraction)
+			cost = this->m_config.slowCost;
+
+		return static_cast<unsigned long>(cost * 1000.0);
+	}
+
+public:
+
+	ProducerThread(const std::string &name, const LoadConfig &config, std::vector<ConsumerThread *> &consumers, const unsigned int seed)
+			: FThread(name, config.producerTps, QUEUE_DISABLED), m_config(config), m_consumers(consumers), m_random(seed)
+	{
+		this->m_pendingTasks = 0.0;
+		this->m_nextConsumer = seed % consumers.size();
+	}
+
+	void onStart() override
+	{
+		this->m_begin = LoadClock::now();
+		this->m_lastTick = this->m_begin;
+	}
+
+	void onTick(const unsigned long currentTime, const unsigned long currentTick) override
+	{
+		LoadClock::time_point now = LoadClock::now();
+		double elapsed = std::chrono::duration<double>(now - this->m_begin).count();
+		double delta = std::chrono::duration<double>(now - this->m_lastTick).count();
+		this->m_lastTick = now;
+
+		this->m_pendingTasks += this->getRate(elapsed) * delta;
+		while (this->m_pendingTasks >= 1.0)
+		{
+			this->m_consumers[this->m_nextConsumer]->post(this->sampleCost());
+			this->m_nextConsumer = (this->m_nextConsumer + 1) % this->m_consumers.size();
+			this->m_pendingTasks -= 1.0;
+		}
+	}
+
+	void onStop() override
+	{
+	}
+};
+
+/**
+ * Gets the resident set size of the process in kilobytes or zero if it is not available.
+ */
+unsigned long getResidentMemory()
+{
+	std::ifstream statm("/proc/self/statm");
+	unsigned long size = 0;
+	unsigned long resident = 0;
+	if (!(statm >> size >> resident))
+		return 0;
+
+	return resident * 4;
+}
+
+bool parseArguments(const int argc, char **argv, LoadConfig &config)
+{
+	for (int n = 1; n < argc; n++)
+	{
+		std::string argument = argv[n];
+		if (argument == "--help" || n + 1 >= argc)
+			return false;
+
+		std::string value = argv[++n];
+		char separator;
+		std::istringstream stream(value);
+		if (argument == "--producers")
+			stream >> config.producers;
+		else if (argument == "--consumers")
+			stream >> config.consumers;
+		else if (argument == "--producer-tps")
+			stream >> config.producerTps;
+		else if (argument == "--consumer-tps")
+			stream >> config.consumerTps;
+		else if (argument == "--consumer-mode")
+			config.consumerMode = value == "queue-only" ? QUEUE_ONLY : QUEUE_ENABLED;
+		else if (argument == "--duration")
+			stream >> config.duration;
+		else if (argument == "--report-interval")
+			stream >> config.reportInterval;
+		else if (argument == "--phase")
+		{
+			RatePhase phase{};
+			stream >> phase.duration >> separator >> phase.rate;
+			config.phases.push_back(phase);
+		}
+		else if (argument == "--burst")
+		{
+			stream >> config.burstPeriod >> separator >> config.burstLength >> separator >> config.burstFactor;
+			config.burstPeriod /= 1000.0;
+			config.burstLength /= 1000.0;
+		}
+		else if (argument == "--cost")
+		{
+			std::string distribution = value.substr(0, value.find(':'));
+			std::istringstream(value.substr(value.find(':') + 1)) >> config.costMean;
+			if (distribution == "uniform")
+				config.costDistribution = COST_UNIFORM;
+			else if (distribution == "exponential")
+				config.costDistribution = COST_EXPONENTIAL;
+			else if (distribution == "pareto")
+				config.costDistribution = COST_PARETO;
+			else
+				config.costDistribution = COST_FIXED;
+		}
+		else if (argument == "--slow")
+			stream >> config.slowFraction >> separator >> config.slowCost;
+		else
+			return false;
+
+		if (stream.fail())
+			return false;
+	}
+
+	if (config.phases.empty())
+		config.phases.push_back({1.0, 1000.0});
+
+	return config.producers > 0 && config.consumers > 0 && config.reportInterval > 0.0;
+}
+
+void printUsage()
+{
+	std::cout << "Usage: FThreadLoadGenerator [options]\n"
+			  << "  --producers M               number of producer FThreads (4)\n"
+			  << "  --consumers N               number of consumer FThreads (2)\n"
+			  << "  --producer-tps TPS          ticks per second of the producers (1000)\n"
+			  << "  --consumer-tps TPS          ticks per second of the consumers, <= 0 for no sleep (1000)\n"
+			  << "  --consumer-mode MODE        queue-enabled or queue-only (queue-enabled)\n"
+			  << "  --duration SECONDS          run time (60)\n"
+			  << "  --report-interval SECONDS   time between two reports (1)\n"
+			  << "  --phase SECONDS:RATE        tasks per second per producer for a phase, repeatable, the script loops (1:1000)\n"
+			  << "  --burst PERIOD:LENGTH:FACTOR multiplies the rate by FACTOR for LENGTH ms every PERIOD ms\n"
+			  << "  --cost DIST:MEAN            fixed, uniform, exponential or pareto task cost in microseconds (fixed:10)\n"
+			  << "  --slow FRACTION:COST        fraction of tasks that take COST microseconds instead\n";
+}
+
+int main(int argc, char **argv)
+{
+	LoadConfig config;
+	if (!parseArguments(argc, argv, config))
+	{
+		printUsage();
+		return 1;
+	}
+
+	// diagnostics go to stderr so they never interleave with the JSON lines on stdout
+	FLogger::setOutput(&std::cerr);
+	FLogger::start();
+
+	std::vector<ConsumerThread *> consumers;
+	std::vector<FThread *> dependencies;
+	std::vector<ProducerThread *> producers;
+	std::vector<std::thread *> threads;
+	for (unsigned int n = 0; n < config.consumers; n++)
+		consumers.push_back(new ConsumerThread("Consumer" + std::to_string(n), config));
+	for (unsigned int n = 0; n < config.producers; n++)
+		producers.push_back(new ProducerThread("Producer" + std::to_string(n), config, consumers, n + 1));
+
+	// producers only start once every consumer accepts tasks
+	for (ConsumerThread *consumer : consumers)
+	{
+		threads.push_back(consumer->start());
+		dependencies.push_back(consumer);
+	}
+	for (ProducerThread *producer : producers)
+		threads.push_back(producer->start(dependencies.size(), dependencies.data()));
+
+	LoadClock::time_point begin = LoadClock::now();
+	LoadClock::time_point nextReport = begin;
+	std::vector<unsigned long> previousCounts(consumers.size() * 2, 0);
+	std::vector<unsigned long> previousHistogram(LatencyHistogram::BUCKETS, 0);
+	unsigned long initialMemory = getResidentMemory();
+
+	while (true)
+	{
+		nextReport += std::chrono::duration_cast<LoadClock::duration>(std::chrono::duration<double>(config.reportInterval));
+		std::this_thread::sleep_until(nextReport);
+
+		double elapsed = std::chrono::duration<double>(LoadClock::now() - begin).count();
+		unsigned long submitted = 0;
+		unsigned long executed = 0;
+		unsigned long queueDepth = 0;
+		unsigned long maxQueueDepth = 0;
+		unsigned long tickAllocations = 0;
+		std::vector<unsigned long> histogram;
+		for (size_t n = 0; n < consumers.size(); n++)
+		{
+			unsigned long consumerExecuted = consumers[n]->executed.load(std::memory_order_relaxed);
+			unsigned long consumerSubmitted = consumers[n]->submitted.load(std::memory_order_relaxed);
+			unsigned long depth = consumerSubmitted > consumerExecuted ? consumerSubmitted - consumerExecuted : 0;
+
+			submitted += consumerSubmitted - previousCounts[n * 2];
+			executed += consumerExecuted - previousCounts[n * 2 + 1];
+			previousCounts[n * 2] = consumerSubmitted;
+			previousCounts[n * 2 + 1] = consumerExecuted;
+			queueDepth += depth;
+			maxQueueDepth = std::max(maxQueueDepth, depth);
+			consumers[n]->latencies.collect(histogram);
+			tickAllocations += consumers[n]->getAllocationStats()->getTickAllocations();
+		}
+
+		unsigned long memory = getResidentMemory();
+		std::cout << std::fixed << std::setprecision(3)
+				  << "{\"elapsed_s\":" << elapsed
+				  << ",\"submitted_per_s\":" << static_cast<double>(submitted) / config.reportInterval
+				  << ",\"executed_per_s\":" << static_cast<double>(executed) / config.reportInterval
+				  << ",\"latency_us_p50\":" << LatencyHistogram::getPercentile(histogram, previousHistogram, 50.0)
+				  << ",\"latency_us_p99\":" << LatencyHistogram::getPercentile(histogram, previousHistogram, 99.0)
+				  << ",\"latency_us_p99.9\":" << LatencyHistogram::getPercentile(histogram, previousHistogram, 99.9)
+				  << ",\"latency_us_max\":" << LatencyHistogram::getPercentile(histogram, previousHistogram, 100.0)
+				  << ",\"queue_depth\":" << queueDepth
+				  << ",\"queue_depth_max\":" << maxQueueDepth
+				  << ",\"rss_kb\":" << memory
+				  << ",\"rss_growth_kb\":" << static_cast<long>(memory) - static_cast<long>(initialMemory);
+		if (FAllocationTracker::ENABLED)
+			std::cout << ",\"consumer_tick_allocations\":" << tickAllocations;
+		std::cout << "}" << std::endl;
+		previousHistogram = histogram;
+
+		if (elapsed >= config.duration)
+			break;
+	}
+
+	bool stoppedInTime = FThread::stopAll(std::chrono::milliseconds(5000));
+	for (std::thread *thread : threads)
+	{
+		thread->join();
+		delete thread;
+	}
+	FMutex::printStatistics();
+	for (ProducerThread *producer : producers)
+		delete producer;
+	for (ConsumerThread *consumer : consumers)
+		delete consumer;
+
+	FLogger::stop();
+	return stoppedInTime ? 0 : 2;
+}
@@ -0,0 +1,200 @@
+/*
+ * FWindowBenchmark.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ *
+ * Benchmark comparing one render FThread per window with a single render FThread driving every window.
+ *
+ * Frame times, achieved frames per second of every window and the CPU usage of the process are printed as one JSON
+ * object per line for 1 to 32 windows. The windows request a redraw every tick, except for the idle model whose windows
+ * only draw their first frame, and share their GL objects, except for the unshared model. The startup time covers the
+ * creation of the windows and their GL objects. Pass --quick to run every configuration for a shorter time.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+#include "FRenderThread.hpp"
+#include "FEventPump.hpp"
+#include "FLogger.hpp"
+#include "BenchmarkCommon.hpp"
+
+
+/**
+ * FWindow that optionally requests a redraw every tick like an animation would.
+ */
+class BenchmarkWindow : public FWindow
+{
+public:
+
+	/**
+	 * Whether the window is drawn every tick.
+	 */
+	bool animated;
+
+	BenchmarkWindow(const std::string &title, const bool animated, FContextGroup *contextGroup)
+			: FWindow(title, 320, 240, {0.0f, 0.5f, 1.0f, 0.0f, 0.0f, -0.5f, -0.5f, 0.0f, 1.0f, 0.0f, 0.5f, -0.5f, 0.0f, 0.0f, 1.0f},
+					vertexShaderSource, fragmentShaderSource, contextGroup)
+	{
+		this->animated = animated;
+	}
+
+	void update(const unsigned long) override
+	{
+		if (this->animated)
+			this->requestRedraw();
+	}
+};
+
+/**
+ * FRenderThread recording how long each of its frames takes while measuring.
+ */
+class BenchmarkRenderThread : public FRenderThread
+{
+public:
+
+	/**
+	 * Whether the frame times are recorded.
+	 */
+	std::atomic_bool measuring;
+	/**
+	 * The recorded frame times in microseconds.
+	 */
+	std::vector<double> frameTimes;
+
+	BenchmarkRenderThread(const std::string &name, FEventPump *eventPump, const SwapSyncMode swapSyncMode)
+			: FRenderThread(name, eventPump, 60.0, swapSyncMode)
+	{
+		this->measuring = false;
+	}
+
+	void onTick(const unsigned long currentTime, const unsigned long currentTick) override
+	{
+		BenchmarkClock::time_point begin = BenchmarkClock::now();
+		FRenderThread::onTick(currentTime, currentTick);
+		if (this->measuring)
+			this->frameTimes.push_back(std::chrono::duration<double, std::micro>(BenchmarkClock::now() - begin).count());
+	}
+};
+
+/**
+ * Renders the given number of windows on the given number of FThreads and measures the frames of every window.
+ *
+ * <p>The windows share their GL objects through one context group unless <code>shareContexts</code> is false.</p>
+ */
+void benchmarkWindows(FEventPump *eventPump, const std::string &model, const unsigned int windows, const unsigned int threads,
+		const SwapSyncMode swapSyncMode, const bool animated = true, const bool shareContexts = true)
+{
+	const std::chrono::milliseconds duration(quickMode ? 500 : 3000);
+
+	FContextGroup contextGroup;
+	std::vector<BenchmarkRenderThread *> renderThreads;
+	for (unsigned int n = 0; n < threads; n++)
+		renderThreads.push_back(new BenchmarkRenderThread("RenderThread-" + std::to_string(n), eventPump, swapSyncMode));
+	for (unsigned int n = 0; n < windows; n++)
+	{
+		renderThreads[n % threads]->addWindow(new BenchmarkWindow("Window " + std::to_string(n), animated,
+				shareContexts ? &contextGroup : nullptr));
+	}
+
+	BenchmarkClock::time_point startBegin = BenchmarkClock::now();
+	std::vector<std::thread *> stdThreads;
+	for (BenchmarkRenderThread *renderThread : renderThreads)
+		stdThreads.push_back(renderThread->start());
+	// the render FThreads create their windows through the pump of the main thread while starting
+	eventPump->run([&renderThreads] {
+		return std::any_of(renderThreads.begin(), renderThreads.end(), [] (BenchmarkRenderThread *renderThread) {
+			return !renderThread->isRunning();
+		});
+	});
+
+	double startupMilliseconds = std::chrono::duration<double, std::milli>(BenchmarkClock::now() - startBegin).count();
+
+	// the first frames include the shader compilation of the drivers
+	BenchmarkClock::time_point warmupEnd = BenchmarkClock::now() + std::chrono::milliseconds(200);
+	eventPump->run([warmupEnd] { return BenchmarkClock::now() < warmupEnd; });
+
+	std::vector<unsigned long> startFrames;
+	for (BenchmarkRenderThread *renderThread : renderThreads)
+	{
+		startFrames.push_back(renderThread->getWindowFrameCount());
+		renderThread->measuring = true;
+	}
+	std::clock_t cpuBegin = std::clock();
+	BenchmarkClock::time_point begin = BenchmarkClock::now();
+
+	BenchmarkClock::time_point end = begin + duration;
+	eventPump->run([end] { return BenchmarkClock::now() < end; });
+
+	for (BenchmarkRenderThread *renderThread : renderThreads)
+		renderThread->measuring = false;
+	double cpuSeconds = static_cast<double>(std::clock() - cpuBegin) / CLOCKS_PER_SEC;
+	double seconds = std::chrono::duration<double>(BenchmarkClock::now() - begin).count();
+
+	unsigned long windowFrames = 0;
+	for (size_t n = 0; n < renderThreads.size(); n++)
+		windowFrames += renderThreads[n]->getWindowFrameCount() - startFrames[n];
+
+	for (BenchmarkRenderThread *renderThread : renderThreads)
+		renderThread->stop();
+	eventPump->run([&renderThreads] {
+		return std::any_of(renderThreads.begin(), renderThreads.end(), [] (BenchmarkRenderThread *renderThread) {
+			return renderThread->hasStarted();
+		});
+	});
+	for (std::thread *thread : stdThreads)
+	{
+		thread->join();
+		delete thread;
+	}
+
+	std::vector<double> frameTimes;
+	for (BenchmarkRenderThread *renderThread : renderThreads)
+	{
+		frameTimes.insert(frameTimes.end(), renderThread->frameTimes.begin(), renderThread->frameTimes.end());
+		delete renderThread;
+	}
+
+	BenchmarkResult("windows")
+			.add("model", model)
+			.add("windows", static_cast<unsigned long>(windows))
+			.add("threads", static_cast<unsigned long>(threads))
+			.add("startup_ms", startupMilliseconds)
+			.add("fps_per_window", static_cast<double>(windowFrames) / windows / seconds)
+			.add("cpu_percent", 100.0 * cpuSeconds / seconds)
+			.addPercentiles("frame_time_us", frameTimes)
+			.print();
+}
+
+int main(int argc, char **argv)
+{
+	for (int n = 1; n < argc; n++)
+	{
+		if (std::strcmp(argv[n], "--quick") == 0)
+			quickMode = true;
+	}
+
+	// the results on stdout stay one JSON object per line
+	FLogger::setOutput(&std::cerr);
+
+	if (!glfwInit())
+		return -1;
+
+	FEventPump eventPump;
+	for (const unsigned int windows : {1u, 2u, 4u, 8u, 16u, 32u})
+	{
+		benchmarkWindows(&eventPump, "thread_per_window", windows, windows, SWAP_SYNC_LAST);
+		benchmarkWindows(&eventPump, "thread_per_window_unshared", windows, windows, SWAP_SYNC_LAST, true, false);
+		benchmarkWindows(&eventPump, "single_thread", windows, 1, SWAP_SYNC_LAST);
+		benchmarkWindows(&eventPump, "single_thread_sync_all", windows, 1, SWAP_SYNC_ALL);
+		benchmarkWindows(&eventPump, "single_thread_idle", windows, 1, SWAP_SYNC_LAST, false);
+	}
+
+	glfwTerminate();
+	return 0;
+}
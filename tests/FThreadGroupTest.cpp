@@ -0,0 +1,160 @@
+/*
+ * FThreadGroupTest.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ *
+ * Test running a synchronized FThreadGroup of three pipeline stages, once on the real clock and repeatedly on an
+ * FVirtualClock. Every member must execute group ticks 0 to 49 without gaps, with frame index group tick minus stage,
+ * and must only begin group tick n once every member has finished group tick n - 1. Exits with 1 on any violation.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <vector>
+
+#include "FThread.hpp"
+#include "FThreadGroup.hpp"
+#include "FClock.hpp"
+
+
+/**
+ * The number of members, one per pipeline stage.
+ */
+const unsigned int MEMBERS = 3;
+/**
+ * The number of group ticks every member executes before it stops itself.
+ */
+const unsigned long GROUP_TICKS = 50;
+
+/**
+ * Group member checking that it ticks in lockstep with the other members.
+ */
+class StageThread : public FThread
+{
+public:
+
+	/**
+	 * The pipeline stage and index of the member.
+	 */
+	unsigned int stage;
+	/**
+	 * The number of group ticks every member has finished, indexed by stage.
+	 */
+	std::atomic_ulong *finished;
+	/**
+	 * The group ticks the member executed.
+	 */
+	std::vector<unsigned long> groupTicks;
+	/**
+	 * The number of ticks with a wrong frame index.
+	 */
+	unsigned long frameErrors;
+	/**
+	 * The number of ticks begun before another member finished the previous group tick or after it finished this one.
+	 */
+	unsigned long lockstepErrors;
+
+	StageThread(const unsigned int stage, std::atomic_ulong *finished)
+			: FThread("Stage" + std::to_string(stage), 200.0, QUEUE_DISABLED)
+	{
+		this->stage = stage;
+		this->finished = finished;
+		this->frameErrors = 0;
+		this->lockstepErrors = 0;
+	}
+
+	void onStart() override
+	{
+	}
+
+	void onTick(const unsigned long, const unsigned long) override
+	{
+		const unsigned long groupTick = this->getGroupTick();
+		this->groupTicks.push_back(groupTick);
+		if (this->getFrameIndex() != static_cast<long>(groupTick) - static_cast<long>(this->stage))
+			this->frameErrors++;
+
+		for (unsigned int n = 0; n < MEMBERS; n++)
+		{
+			const unsigned long done = this->finished[n];
+			if (done < groupTick || done > groupTick + 1)
+				this->lockstepErrors++;
+		}
+
+		this->finished[this->stage] = groupTick + 1;
+		if (groupTick + 1 == GROUP_TICKS)
+			this->stop();
+	}
+
+	void onStop() override
+	{
+	}
+};
+
+/**
+ * Runs the group once and reports its violations.
+ *
+ * @return <code>false</code> if any member did not tick in lockstep.
+ */
+bool runGroup(const std::string &name, FVirtualClock *clock)
+{
+	std::atomic_ulong finished[MEMBERS];
+	std::vector<StageThread *> members;
+	FThreadGroup group(200.0, true);
+	for (unsigned int stage = 0; stage < MEMBERS; stage++)
+	{
+		finished[stage] = 0;
+		members.push_back(new StageThread(stage, finished));
+		if (clock != nullptr)
+			members.back()->setClock(clock);
+		group.addMember(members.back(), std::chrono::microseconds(0), stage);
+	}
+
+	// started one after another without any pause, the barrier alone keeps the members together
+	std::vector<std::thread *> threads;
+	for (StageThread *member : members)
+		threads.push_back(member->start());
+	for (std::thread *thread : threads)
+	{
+		thread->join();
+		delete thread;
+	}
+
+	bool passed = true;
+	for (StageThread *member : members)
+	{
+		bool consecutive = member->groupTicks.size() == GROUP_TICKS;
+		for (unsigned long n = 0; consecutive && n < GROUP_TICKS; n++)
+			consecutive = member->groupTicks[n] == n;
+
+		if (!consecutive || member->frameErrors > 0 || member->lockstepErrors > 0)
+		{
+			std::cerr << name << ": stage " << member->stage << " executed " << member->groupTicks.size()
+					<< " group ticks starting at " << (member->groupTicks.empty() ? 0 : member->groupTicks.front())
+					<< ", " << member->frameErrors << " wrong frame indices, " << member->lockstepErrors << " lockstep violations"
+					<< std::endl;
+			passed = false;
+		}
+		delete member;
+	}
+	return passed;
+}
+
+int main()
+{
+	int failures = 0;
+	if (!runGroup("real clock", nullptr))
+		failures++;
+
+	const int virtualRuns = 30;
+	for (int run = 0; run < virtualRuns; run++)
+	{
+		FVirtualClock clock;
+		if (!runGroup("virtual clock run " + std::to_string(run), &clock))
+			failures++;
+	}
+
+	std::cout << (virtualRuns + 1 - failures) << " of " << (virtualRuns + 1) << " runs in lockstep" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
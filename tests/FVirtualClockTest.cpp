@@ -0,0 +1,103 @@
+/*
+ * FVirtualClockTest.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: marce
+ *
+ * Test running two FThreads with 60 and 1000 ticks per second on a paused FVirtualClock. Once the slow FThread executed
+ * 60 ticks both are stopped, at which point the fast FThread must have executed exactly the ticks scheduled up to the
+ * same virtual time, in every run. Exits with 1 if any run differs.
+ */
+
+#include <iostream>
+
+#include "FThread.hpp"
+#include "FClock.hpp"
+
+
+/**
+ * FThread counting its ticks and stopping itself and another FThread after a given number of ticks.
+ */
+class CountingThread : public FThread
+{
+public:
+
+	/**
+	 * The number of executed ticks.
+	 */
+	unsigned long ticks;
+	/**
+	 * The number of ticks after which the FThreads stop, zero to run until stopped.
+	 */
+	unsigned long stopAfter;
+	/**
+	 * The FThread stopped together with this one or <code>nullptr</code>.
+	 */
+	FThread *other;
+
+	CountingThread(const std::string &name, const double ticksPerSecond, const unsigned long stopAfter, FThread *other)
+			: FThread(name, ticksPerSecond, QUEUE_DISABLED)
+	{
+		this->ticks = 0;
+		this->stopAfter = stopAfter;
+		this->other = other;
+	}
+
+	void onStart() override
+	{
+	}
+
+	void onTick(const unsigned long, const unsigned long) override
+	{
+		if (++this->ticks != this->stopAfter)
+			return;
+
+		this->other->stop();
+		this->stop();
+	}
+
+	void onStop() override
+	{
+	}
+};
+
+int main()
+{
+	const int runs = 30;
+	const unsigned long slowTicks = 60;
+	int failures = 0;
+
+	for (int run = 0; run < runs; run++)
+	{
+		FVirtualClock clock;
+		CountingThread fast("Fast", 1000.0, 0, nullptr);
+		CountingThread slow("Slow", 60.0, slowTicks, &fast);
+		fast.setClock(&clock);
+		slow.setClock(&clock);
+
+		// without the pause the FThread started first could run the clock ahead before the other one is started
+		clock.pause();
+		std::thread *fastThread = fast.start();
+		std::thread *slowThread = slow.start();
+		clock.resume();
+
+		slowThread->join();
+		fastThread->join();
+		delete slowThread;
+		delete fastThread;
+
+		// the last slow tick happens at 59 periods of 16666 us, the fast FThread ticks every 1000 us from 0 up to it
+		const auto end = std::chrono::microseconds(static_cast<long>(1000000 / 60.0) * (slowTicks - 1));
+		const unsigned long expectedFastTicks = static_cast<unsigned long>(end.count() / 1000) + 1;
+		if (slow.ticks != slowTicks || fast.ticks != expectedFastTicks || clock.now() != end)
+		{
+			std::cerr << "run " << run << ": slow ticks " << slow.ticks << ", fast ticks " << fast.ticks << " instead of "
+					<< expectedFastTicks << ", ended at " << clock.now().count() << " us instead of " << end.count() << " us"
+					<< std::endl;
+			failures++;
+		}
+	}
+
+	std::cout << (runs - failures) << " of " << runs << " runs deterministic" << std::endl;
+	return failures == 0 ? 0 : 1;
+}